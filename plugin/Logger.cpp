@@ -1,4 +1,7 @@
 #include "Logger.h"
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
@@ -48,16 +51,33 @@ bool Logger::Initialize(const std::filesystem::path& iniPath, const std::filesys
 
         m_logLevel = configuredLevel;
 
+        // Messages are formatted on the calling thread and written by one worker thread, so the game
+        // thread never waits for the disk. The pool is leaked like the plugin's other worker threads:
+        // it must not be joined from a static destructor.
+        static auto* threadPool =
+            new std::shared_ptr<spdlog::details::thread_pool>(std::make_shared<spdlog::details::thread_pool>(kQueueSize, 1));
+        m_threadPool = *threadPool;
+
         // Create spdlog logger
         auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(logPath.string(), true);
-        m_logger = std::make_shared<spdlog::logger>("KnowYourLimits", std::move(sink));
+        m_logger = std::make_shared<spdlog::async_logger>("KnowYourLimits", sink, m_threadPool,
+                                                          spdlog::async_overflow_policy::overrun_oldest);
+
+        // Warnings and errors are rare and matter most right before a crash: they skip the queue, which
+        // can drop them or die with the process, and are written and flushed before the call returns.
+        // They may land ahead of info lines still queued.
+        m_syncLogger = std::make_shared<spdlog::logger>("KnowYourLimits.sync", std::move(sink));
 
         // Set spdlog level
-        m_logger->set_level(ToSpdlogLevel(m_logLevel));
-        m_logger->flush_on(spdlog::level::info);
-        m_logger->set_pattern("[%H:%M:%S] [%l] %v");
+        for (const auto& logger : {m_logger, m_syncLogger}) {
+            logger->set_level(ToSpdlogLevel(m_logLevel));
+            logger->set_pattern("[%H:%M:%S] [%l] %v");
+        }
+        m_syncLogger->flush_on(spdlog::level::warn);
 
         spdlog::set_default_logger(m_logger);
+        // Queued lines reach the disk within a second
+        spdlog::flush_every(std::chrono::seconds(1));
 
         m_logger->info("Logger initialized with level: {}", static_cast<int>(m_logLevel));
         m_logger->info("Log file: {}", logPath.string());
@@ -70,6 +90,10 @@ bool Logger::Initialize(const std::filesystem::path& iniPath, const std::filesys
     }
 }
 
+std::size_t Logger::GetDroppedCount() const {
+    return m_threadPool ? m_threadPool->overrun_counter() : 0;
+}
+
 Logger::Level Logger::ParseLogLevel(const std::string& levelStr) {
     // Convert to lowercase for case-insensitive comparison
     std::string lower = levelStr;
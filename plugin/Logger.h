@@ -1,11 +1,17 @@
 #pragma once
 
 #include <spdlog/spdlog.h>
-#include <spdlog/sinks/basic_file_sink.h>
+#include <cstddef>
 #include <filesystem>
 #include <string>
 #include <memory>
 
+// Lowest log level compiled in (0 = trace ... 6 = off). LOG_* calls below it are discarded at compile
+// time together with their arguments; the build defaults to trace for Debug and info otherwise.
+#ifndef KYL_LOG_MIN_LEVEL
+#define KYL_LOG_MIN_LEVEL 0
+#endif
+
 namespace KYL {
 
 class Logger {
@@ -20,6 +26,10 @@ public:
         Off = 6
     };
 
+    // Messages waiting for the writer thread; when full, the oldest queued message is overwritten so
+    // logging never blocks the calling thread. Warnings and above bypass the queue (see Initialize).
+    static constexpr std::size_t kQueueSize = 8192;
+
     static Logger& GetInstance();
 
     // Initialize logger with INI file configuration
@@ -28,7 +38,13 @@ public:
     // Get the current log level
     Level GetLogLevel() const { return m_logLevel; }
 
-    // Get the underlying spdlog logger
+    // Whether a message at level would be written; the LOG_* macros check this before evaluating arguments
+    bool ShouldLog(Level level) const { return m_logger && m_logLevel <= level; }
+
+    // Messages lost because the queue was full
+    std::size_t GetDroppedCount() const;
+
+    // Get the underlying (queued) spdlog logger
     std::shared_ptr<spdlog::logger> GetLogger() const { return m_logger; }
 
     // Convenience logging functions
@@ -56,21 +72,21 @@ public:
     template<typename... Args>
     void Warn(fmt::format_string<Args...> fmt, Args&&... args) {
         if (m_logger && m_logLevel <= Level::Warning) {
-            m_logger->warn(fmt, std::forward<Args>(args)...);
+            m_syncLogger->warn(fmt, std::forward<Args>(args)...);
         }
     }
 
     template<typename... Args>
     void Error(fmt::format_string<Args...> fmt, Args&&... args) {
         if (m_logger && m_logLevel <= Level::Error) {
-            m_logger->error(fmt, std::forward<Args>(args)...);
+            m_syncLogger->error(fmt, std::forward<Args>(args)...);
         }
     }
 
     template<typename... Args>
     void Critical(fmt::format_string<Args...> fmt, Args&&... args) {
         if (m_logger && m_logLevel <= Level::Critical) {
-            m_logger->critical(fmt, std::forward<Args>(args)...);
+            m_syncLogger->critical(fmt, std::forward<Args>(args)...);
         }
     }
 
@@ -87,15 +103,28 @@ private:
     spdlog::level::level_enum ToSpdlogLevel(Level level);
 
     std::shared_ptr<spdlog::logger> m_logger;
+    // Same file, written and flushed on the calling thread
+    std::shared_ptr<spdlog::logger> m_syncLogger;
+    std::shared_ptr<spdlog::details::thread_pool> m_threadPool;
     Level m_logLevel{Level::Info};
 };
 
 }  // namespace KYL
 
-// Global convenience macros
-#define LOG_TRACE(...) KYL::Logger::GetInstance().Trace(__VA_ARGS__)
-#define LOG_DEBUG(...) KYL::Logger::GetInstance().Debug(__VA_ARGS__)
-#define LOG_INFO(...) KYL::Logger::GetInstance().Info(__VA_ARGS__)
-#define LOG_WARN(...) KYL::Logger::GetInstance().Warn(__VA_ARGS__)
-#define LOG_ERROR(...) KYL::Logger::GetInstance().Error(__VA_ARGS__)
-#define LOG_CRITICAL(...) KYL::Logger::GetInstance().Critical(__VA_ARGS__)
+// Global convenience macros. Arguments are only evaluated when the level is enabled at run time, and
+// calls below KYL_LOG_MIN_LEVEL compile to nothing (they are still type-checked).
+#define KYL_LOG_AT(level, method, ...)                                                      \
+    do {                                                                                    \
+        if constexpr (static_cast<int>(level) >= KYL_LOG_MIN_LEVEL) {                       \
+            if (auto& kylLogger = KYL::Logger::GetInstance(); kylLogger.ShouldLog(level)) { \
+                kylLogger.method(__VA_ARGS__);                                              \
+            }                                                                               \
+        }                                                                                   \
+    } while (false)
+
+#define LOG_TRACE(...) KYL_LOG_AT(KYL::Logger::Level::Trace, Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) KYL_LOG_AT(KYL::Logger::Level::Debug, Debug, __VA_ARGS__)
+#define LOG_INFO(...) KYL_LOG_AT(KYL::Logger::Level::Info, Info, __VA_ARGS__)
+#define LOG_WARN(...) KYL_LOG_AT(KYL::Logger::Level::Warning, Warn, __VA_ARGS__)
+#define LOG_ERROR(...) KYL_LOG_AT(KYL::Logger::Level::Error, Error, __VA_ARGS__)
+#define LOG_CRITICAL(...) KYL_LOG_AT(KYL::Logger::Level::Critical, Critical, __VA_ARGS__)
@@ -0,0 +1,80 @@
+#include "SkseSkeleton.h"
+
+#include "RE/N/NiAVObject.h"
+
+namespace KYL {
+
+    RE::NiPointer<RE::Actor> SkseSkeleton::LookupActor(ActorHandle handle) {
+        RE::NiPointer<RE::Actor> actor;
+        RE::Actor::LookupByHandle(static_cast<RE::RefHandle>(handle), actor);
+        return actor;
+    }
+
+    std::string SkseSkeleton::GetActorName(RE::Actor* actor) {
+        if (!actor) {
+            return "<none>";
+        }
+
+        if (const char* name = actor->GetDisplayFullName(); name && *name != '\0') {
+            return name;
+        }
+
+        if (const char* baseName = actor->GetName(); baseName && *baseName != '\0') {
+            return baseName;
+        }
+
+        return "<unnamed>";
+    }
+
+    bool SkseSkeleton::IsActorValid(ActorHandle actor) { return static_cast<bool>(LookupActor(actor)); }
+
+    std::string SkseSkeleton::GetActorName(ActorHandle actor) { return GetActorName(LookupActor(actor).get()); }
+
+    NodeRef SkseSkeleton::FindNode(ActorHandle actor, const std::string& nodeName) {
+        auto actorPtr = LookupActor(actor);
+        if (!actorPtr) {
+            return nullptr;
+        }
+
+        const RE::BSFixedString name(nodeName.c_str());
+        return FromNiNode(actorPtr->GetNodeByName(name));
+    }
+
+    void SkseSkeleton::RetainNode(NodeRef node) {
+        if (auto* niNode = ToNiNode(node)) {
+            niNode->IncRefCount();
+        }
+    }
+
+    void SkseSkeleton::ReleaseNode(NodeRef node) {
+        if (auto* niNode = ToNiNode(node)) {
+            niNode->DecRefCount();
+        }
+    }
+
+    Vector3 SkseSkeleton::GetWorldTranslate(NodeRef node) {
+        const auto& translate = ToNiNode(node)->world.translate;
+        return {translate.x, translate.y, translate.z};
+    }
+
+    float SkseSkeleton::GetWorldScale(NodeRef node) { return ToNiNode(node)->world.scale; }
+
+    Vector3 SkseSkeleton::GetLocalTranslate(NodeRef node) {
+        const auto& translate = ToNiNode(node)->local.translate;
+        return {translate.x, translate.y, translate.z};
+    }
+
+    void SkseSkeleton::SetLocalTranslate(NodeRef node, const Vector3& translate) {
+        ToNiNode(node)->local.translate = RE::NiPoint3{translate.x, translate.y, translate.z};
+    }
+
+    NodeRef SkseSkeleton::GetParent(NodeRef node) { return FromNiNode(ToNiNode(node)->parent); }
+
+    void SkseSkeleton::UpdateWorldData(NodeRef node) {
+        if (auto* niNode = ToNiNode(node)) {
+            RE::NiUpdateData updateData;
+            niNode->UpdateWorldData(&updateData);
+        }
+    }
+
+}  // namespace KYL
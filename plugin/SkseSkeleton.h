@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+#include "PCH.h"
+#include "Skeleton.h"
+
+namespace KYL {
+
+    // ISkeleton backend on top of RE::Actor / RE::NiAVObject
+    class SkseSkeleton final : public ISkeleton {
+    public:
+        static RE::NiAVObject* ToNiNode(NodeRef node) { return reinterpret_cast<RE::NiAVObject*>(node); }
+        static NodeRef FromNiNode(RE::NiAVObject* node) { return reinterpret_cast<NodeRef>(node); }
+
+        static RE::NiPointer<RE::Actor> LookupActor(ActorHandle handle);
+        static std::string GetActorName(RE::Actor* actor);
+
+        bool IsActorValid(ActorHandle actor) override;
+        std::string GetActorName(ActorHandle actor) override;
+        NodeRef FindNode(ActorHandle actor, const std::string& nodeName) override;
+
+        void RetainNode(NodeRef node) override;
+        void ReleaseNode(NodeRef node) override;
+
+        Vector3 GetWorldTranslate(NodeRef node) override;
+        float GetWorldScale(NodeRef node) override;
+        Vector3 GetLocalTranslate(NodeRef node) override;
+        void SetLocalTranslate(NodeRef node, const Vector3& translate) override;
+        NodeRef GetParent(NodeRef node) override;
+        void UpdateWorldData(NodeRef node) override;
+    };
+
+}  // namespace KYL
@@ -0,0 +1,42 @@
+#include "AllocationCounter.h"
+
+#ifdef KYL_TRACK_ALLOCATIONS
+    #include <cstdlib>
+    #include <new>
+#endif
+
+namespace KYL {
+
+    namespace {
+        // Plain per-thread counter so the replaced operator new stays allocation- and lock-free
+        thread_local std::uint64_t t_allocations = 0;
+    }
+
+    AllocationScope::AllocationScope() : m_start(t_allocations) {}
+
+    AllocationScope::~AllocationScope() = default;
+
+    std::uint64_t AllocationScope::Count() const { return t_allocations - m_start; }
+
+}  // namespace KYL
+
+#ifdef KYL_TRACK_ALLOCATIONS
+
+namespace {
+    void* CountedAllocate(std::size_t size) {
+        ++KYL::t_allocations;
+        if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return CountedAllocate(size); }
+void* operator new[](std::size_t size) { return CountedAllocate(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+#endif
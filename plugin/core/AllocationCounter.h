@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+namespace KYL {
+
+    // Debug instrumentation that counts heap allocations made on the current thread while a scope is
+    // open. Only active when built with KYL_TRACK_ALLOCATIONS (host builds and Debug DLLs), which
+    // replaces the global operator new/delete of the module; otherwise every count stays zero.
+    class AllocationScope {
+    public:
+        AllocationScope();
+        ~AllocationScope();
+
+        AllocationScope(const AllocationScope&) = delete;
+        AllocationScope& operator=(const AllocationScope&) = delete;
+
+        // Allocations made on this thread since the scope was opened
+        std::uint64_t Count() const;
+
+        static constexpr bool IsEnabled() {
+#ifdef KYL_TRACK_ALLOCATIONS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+    private:
+        std::uint64_t m_start{0};
+    };
+
+}  // namespace KYL
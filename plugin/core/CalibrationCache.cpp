@@ -0,0 +1,206 @@
+#include "CalibrationCache.h"
+
+#include <chrono>
+#include <cstring>
+
+#include "Logger.h"
+
+namespace KYL {
+
+    namespace {
+        // Queued updates reach the mapping within this long even if nobody wakes the writer
+        constexpr auto kWriterInterval = std::chrono::seconds{1};
+
+        constexpr std::uint64_t kFnvOffset = 0xcbf29ce484222325ull;
+        constexpr std::uint64_t kFnvPrime = 0x100000001b3ull;
+
+        std::uint64_t Fnv1a(std::uint64_t hash, std::string_view text) {
+            for (const char c : text) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * kFnvPrime;
+            }
+            // Separator so ("ab", "c") and ("a", "bc") differ
+            return (hash ^ 0xFFu) * kFnvPrime;
+        }
+    }
+
+    CalibrationCache::Key CalibrationCache::MakeKey(std::string_view scene, std::string_view targetNode,
+                                                    const std::vector<std::string>& probeNodes) {
+        std::uint64_t chainHash = kFnvOffset;
+        for (const auto& name : probeNodes) {
+            chainHash = Fnv1a(chainHash, name);
+        }
+
+        std::uint64_t key = Fnv1a(Fnv1a(kFnvOffset, scene), targetNode);
+        key = (key ^ chainHash) * kFnvPrime;
+        return key != 0 ? key : 1;
+    }
+
+    CalibrationCache::~CalibrationCache() { Close(); }
+
+    bool CalibrationCache::Open(const std::filesystem::path& path) {
+        Close();
+
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (!m_file.Open(path, FileSize(kInitialCapacity))) {
+            LOG_ERROR("Calibration cache: cannot map {}", path.string());
+            return false;
+        }
+        if (!IsValid()) {
+            LOG_WARN("Calibration cache: {} is missing or unreadable, starting empty", path.string());
+            if (!m_file.Resize(FileSize(kInitialCapacity))) {
+                m_file.Close();
+                return false;
+            }
+            Format(kInitialCapacity);
+        }
+
+        m_stats = {};
+        m_stats.entries = GetHeader().count;
+        m_stopRequested = false;
+        m_writer = std::thread([this]() { WriterMain(); });
+        LOG_INFO("Calibration cache: {} entries loaded from {}", m_stats.entries, path.string());
+        return true;
+    }
+
+    void CalibrationCache::Close() {
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_stopRequested = true;
+        }
+        m_wake.notify_all();
+        if (m_writer.joinable()) {
+            m_writer.join();
+        }
+
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_file.IsOpen()) {
+            DrainUpdates();
+            m_file.FlushAsync();
+            m_file.Close();
+        }
+    }
+
+    bool CalibrationCache::IsOpen() const {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_file.IsOpen();
+    }
+
+    std::optional<Calibration> CalibrationCache::Find(Key key) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (!m_file.IsOpen()) {
+            return std::nullopt;
+        }
+
+        const Record* record = Slot(key);
+        if (record->key != key) {
+            ++m_stats.misses;
+            return std::nullopt;
+        }
+        ++m_stats.hits;
+        return record->calibration;
+    }
+
+    void CalibrationCache::Store(Key key, const Calibration& calibration) {
+        m_updates.Push(Update{key, calibration});
+        m_pending.store(true, std::memory_order_release);
+        m_wake.notify_one();
+    }
+
+    CalibrationCache::Stats CalibrationCache::GetStats() const {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_stats;
+    }
+
+    bool CalibrationCache::IsValid() const {
+        if (m_file.Size() < sizeof(Header)) {
+            return false;
+        }
+        const Header& header = GetHeader();
+        return header.magic == kMagic && header.version == kVersion && header.capacity > 0 &&
+               (header.capacity & (header.capacity - 1)) == 0 && header.count < header.capacity &&
+               m_file.Size() >= FileSize(header.capacity);
+    }
+
+    void CalibrationCache::Format(std::uint32_t capacity) {
+        std::memset(m_file.Data(), 0, FileSize(capacity));
+        GetHeader() = Header{kMagic, kVersion, capacity, 0};
+    }
+
+    CalibrationCache::Record* CalibrationCache::Slot(Key key) const {
+        // Linear probing over a power-of-two table kept at most three quarters full
+        const std::uint32_t mask = GetHeader().capacity - 1;
+        Record* records = Records();
+        for (auto index = static_cast<std::uint32_t>(key) & mask;; index = (index + 1) & mask) {
+            if (records[index].key == key || records[index].key == 0) {
+                return &records[index];
+            }
+        }
+    }
+
+    bool CalibrationCache::Grow() {
+        const std::uint32_t capacity = GetHeader().capacity;
+        std::vector<Record> live;
+        live.reserve(GetHeader().count);
+        for (std::uint32_t i = 0; i < capacity; ++i) {
+            if (Records()[i].key != 0) {
+                live.push_back(Records()[i]);
+            }
+        }
+
+        if (!m_file.Resize(FileSize(capacity * 2))) {
+            LOG_ERROR("Calibration cache: cannot grow to {} entries", capacity * 2);
+            return false;
+        }
+        Format(capacity * 2);
+        for (const auto& record : live) {
+            *Slot(record.key) = record;
+        }
+        GetHeader().count = static_cast<std::uint32_t>(live.size());
+        return true;
+    }
+
+    void CalibrationCache::Apply(const Update& update) {
+        Record* record = Slot(update.key);
+        if (record->key == 0) {
+            if ((GetHeader().count + 1) * 4 > GetHeader().capacity * 3) {
+                if (!Grow()) {
+                    return;
+                }
+                record = Slot(update.key);
+            }
+            ++GetHeader().count;
+            record->key = update.key;
+        }
+        record->calibration = update.calibration;
+        ++m_stats.stored;
+        m_stats.entries = GetHeader().count;
+    }
+
+    bool CalibrationCache::DrainUpdates() {
+        m_pending.store(false, std::memory_order_relaxed);
+        bool applied = false;
+        Update update;
+        while (m_updates.TryPop(update)) {
+            if (m_file.IsOpen()) {
+                Apply(update);
+                applied = true;
+            }
+        }
+        return applied;
+    }
+
+    void CalibrationCache::WriterMain() {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        while (!m_stopRequested) {
+            m_wake.wait_for(lk, kWriterInterval, [this]() {
+                return m_stopRequested || m_pending.load(std::memory_order_acquire);
+            });
+
+            // The mapping already holds the data; this only starts the write-back to disk
+            if (DrainUpdates()) {
+                m_file.FlushAsync();
+            }
+        }
+    }
+
+}  // namespace KYL
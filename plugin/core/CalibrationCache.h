@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "MappedFile.h"
+#include "MpscQueue.h"
+
+namespace KYL {
+
+    // Learned penetration maxima of one scene/action, target bone and probe chain
+    struct Calibration {
+        float maxPenetration{0.0f};
+        float maxPenetrationBeyondThreshold{0.0f};
+        // Shrink threshold the maximum beyond it was learned against
+        float distanceThreshold{0.0f};
+    };
+
+    // Persistent store of learned maxima so a monitor recreated for a scene it has seen before starts
+    // from what was learned there instead of from zero. The file is a memory-mapped open-addressing hash
+    // table of fixed-size records keyed by a 64-bit hash; lookups read the mapping directly.
+    //
+    // Find may be called from any thread. Store never blocks: updates are queued and a writer thread
+    // applies them to the mapping and starts the write-back to disk.
+    class CalibrationCache {
+    public:
+        using Key = std::uint64_t;
+
+        struct Stats {
+            std::uint64_t hits{0};
+            std::uint64_t misses{0};
+            std::uint64_t stored{0};
+            std::size_t entries{0};
+        };
+
+        // Non-zero key of a monitor; scene names the scene or action the monitor was registered for
+        static Key MakeKey(std::string_view scene, std::string_view targetNode,
+                           const std::vector<std::string>& probeNodes);
+
+        CalibrationCache() = default;
+        ~CalibrationCache();
+
+        CalibrationCache(const CalibrationCache&) = delete;
+        CalibrationCache& operator=(const CalibrationCache&) = delete;
+
+        // Map the cache file (created or reset if missing or unreadable) and start the writer thread
+        bool Open(const std::filesystem::path& path);
+
+        // Apply queued updates, flush and stop the writer thread
+        void Close();
+
+        bool IsOpen() const;
+        std::optional<Calibration> Find(Key key);
+        void Store(Key key, const Calibration& calibration);
+        Stats GetStats() const;
+
+    private:
+        static constexpr std::uint32_t kMagic = 0x434C594B;  // "KYLC"
+        static constexpr std::uint32_t kVersion = 1;
+        static constexpr std::uint32_t kInitialCapacity = 1024;
+
+        struct Header {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t capacity;
+            std::uint32_t count;
+        };
+
+        struct Record {
+            Key key;  // 0 = empty slot
+            Calibration calibration;
+            std::uint32_t reserved;
+        };
+        static_assert(sizeof(Record) == 24);
+
+        struct Update {
+            Key key{0};
+            Calibration calibration;
+        };
+
+        static std::size_t FileSize(std::uint32_t capacity) {
+            return sizeof(Header) + static_cast<std::size_t>(capacity) * sizeof(Record);
+        }
+
+        Header& GetHeader() const { return *reinterpret_cast<Header*>(m_file.Data()); }
+        Record* Records() const { return reinterpret_cast<Record*>(m_file.Data() + sizeof(Header)); }
+        bool IsValid() const;
+        void Format(std::uint32_t capacity);
+        Record* Slot(Key key) const;
+        bool Grow();
+        void Apply(const Update& update);
+        bool DrainUpdates();
+        void WriterMain();
+
+        mutable std::mutex m_mutex;
+        MappedFile m_file;
+        Stats m_stats;
+
+        MpscQueue<Update> m_updates;
+        std::thread m_writer;
+        std::condition_variable m_wake;
+        std::atomic<bool> m_pending{false};
+        bool m_stopRequested{false};
+    };
+
+}  // namespace KYL
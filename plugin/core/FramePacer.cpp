@@ -0,0 +1,33 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+
+namespace KYL {
+
+    void FramePacer::SetDivisor(std::uint32_t divisor) {
+        m_divisor.store(std::max<std::uint32_t>(divisor, 1), std::memory_order_relaxed);
+    }
+
+    bool FramePacer::OnFrame() {
+        ++m_frames;
+
+        if (m_restartRequested.exchange(false, std::memory_order_acq_rel)) {
+            m_phase = 0;
+        }
+
+        // Divisor may shrink between frames; wrap the phase so the next run is never more than N frames away
+        const std::uint32_t divisor = GetDivisor();
+        if (m_phase >= divisor) {
+            m_phase = 0;
+        }
+
+        const bool run = m_phase == 0;
+        m_phase = m_phase + 1 == divisor ? 0 : m_phase + 1;
+
+        if (run) {
+            ++m_ticks;
+        }
+        return run;
+    }
+
+}  // namespace KYL
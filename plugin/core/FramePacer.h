@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace KYL {
+
+    // Frame-phase logic for frame-synchronized ticks: the frame source (the main-thread update hook
+    // in game, a simulated loop on the host) calls OnFrame once per frame and runs the monitor pass
+    // when it returns true, i.e. on every Nth frame.
+    class FramePacer {
+    public:
+        // 1 = every frame; values below 1 are clamped to 1
+        void SetDivisor(std::uint32_t divisor);
+        std::uint32_t GetDivisor() const { return m_divisor.load(std::memory_order_relaxed); }
+
+        // Realign the phase so the next frame runs the pass
+        void Restart() { m_restartRequested.store(true, std::memory_order_release); }
+
+        // Advance by one frame; returns true if this frame should run the monitor pass
+        bool OnFrame();
+
+        std::uint64_t GetFrameCount() const { return m_frames; }
+        std::uint64_t GetTickCount() const { return m_ticks; }
+
+    private:
+        std::atomic<std::uint32_t> m_divisor{1};
+        std::atomic<bool> m_restartRequested{false};
+
+        // Only touched by the frame source thread
+        std::uint32_t m_phase{0};
+        std::uint64_t m_frames{0};
+        std::uint64_t m_ticks{0};
+    };
+
+}  // namespace KYL
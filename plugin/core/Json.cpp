@@ -0,0 +1,283 @@
+#include "Json.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace KYL {
+
+    class JsonParser {
+    public:
+        explicit JsonParser(std::string_view text) : m_text(text) {}
+
+        std::optional<JsonValue> ParseDocument(std::string& error) {
+            if (m_text.starts_with("\xEF\xBB\xBF")) {
+                m_pos = 3;
+            }
+
+            JsonValue root;
+            if (!ParseValue(root, 0)) {
+                error = Describe();
+                return std::nullopt;
+            }
+            SkipWhitespace();
+            if (m_pos != m_text.size()) {
+                Fail("unexpected content after the document");
+                error = Describe();
+                return std::nullopt;
+            }
+            return root;
+        }
+
+    private:
+        // Deeper nesting is rejected instead of risking the stack
+        static constexpr int kMaxDepth = 64;
+
+        bool Fail(const char* reason) {
+            if (!m_error) {
+                m_error = reason;
+                m_errorPos = m_pos;
+            }
+            return false;
+        }
+
+        std::string Describe() const {
+            const auto end = m_text.begin() + static_cast<std::ptrdiff_t>(std::min(m_errorPos, m_text.size()));
+            const auto line = std::count(m_text.begin(), end, '\n') + 1;
+            return "line " + std::to_string(line) + ": " + (m_error ? m_error : "invalid JSON");
+        }
+
+        void SkipWhitespace() {
+            while (m_pos < m_text.size() &&
+                   (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\n' || m_text[m_pos] == '\r')) {
+                ++m_pos;
+            }
+        }
+
+        bool Consume(char c) {
+            SkipWhitespace();
+            if (m_pos < m_text.size() && m_text[m_pos] == c) {
+                ++m_pos;
+                return true;
+            }
+            return false;
+        }
+
+        bool ConsumeLiteral(std::string_view literal) {
+            if (m_text.substr(m_pos, literal.size()) != literal) {
+                return Fail("unknown literal");
+            }
+            m_pos += literal.size();
+            return true;
+        }
+
+        bool ParseValue(JsonValue& out, int depth) {
+            if (depth > kMaxDepth) {
+                return Fail("nesting too deep");
+            }
+
+            SkipWhitespace();
+            if (m_pos >= m_text.size()) {
+                return Fail("unexpected end of input");
+            }
+
+            switch (m_text[m_pos]) {
+                case '{':
+                    return ParseObject(out, depth);
+                case '[':
+                    return ParseArray(out, depth);
+                case '"':
+                    out.m_type = JsonValue::Type::String;
+                    return ParseString(out.m_string);
+                case 't':
+                    out.m_type = JsonValue::Type::Bool;
+                    out.m_bool = true;
+                    return ConsumeLiteral("true");
+                case 'f':
+                    out.m_type = JsonValue::Type::Bool;
+                    out.m_bool = false;
+                    return ConsumeLiteral("false");
+                case 'n':
+                    out.m_type = JsonValue::Type::Null;
+                    return ConsumeLiteral("null");
+                default:
+                    return ParseNumber(out);
+            }
+        }
+
+        bool ParseObject(JsonValue& out, int depth) {
+            out.m_type = JsonValue::Type::Object;
+            ++m_pos;
+            if (Consume('}')) {
+                return true;
+            }
+
+            do {
+                SkipWhitespace();
+                std::string key;
+                if (m_pos >= m_text.size() || m_text[m_pos] != '"') {
+                    return Fail("expected a member name");
+                }
+                if (!ParseString(key)) {
+                    return false;
+                }
+                if (!Consume(':')) {
+                    return Fail("expected ':' after member name");
+                }
+
+                JsonValue value;
+                if (!ParseValue(value, depth + 1)) {
+                    return false;
+                }
+                out.m_keys.push_back(std::move(key));
+                out.m_items.push_back(std::move(value));
+            } while (Consume(','));
+
+            return Consume('}') || Fail("expected ',' or '}'");
+        }
+
+        bool ParseArray(JsonValue& out, int depth) {
+            out.m_type = JsonValue::Type::Array;
+            ++m_pos;
+            if (Consume(']')) {
+                return true;
+            }
+
+            do {
+                JsonValue value;
+                if (!ParseValue(value, depth + 1)) {
+                    return false;
+                }
+                out.m_items.push_back(std::move(value));
+            } while (Consume(','));
+
+            return Consume(']') || Fail("expected ',' or ']'");
+        }
+
+        bool ParseHex4(std::uint32_t& out) {
+            if (m_pos + 4 > m_text.size()) {
+                return Fail("truncated \\u escape");
+            }
+            const auto* first = m_text.data() + m_pos;
+            const auto [ptr, ec] = std::from_chars(first, first + 4, out, 16);
+            if (ec != std::errc{} || ptr != first + 4) {
+                return Fail("invalid \\u escape");
+            }
+            m_pos += 4;
+            return true;
+        }
+
+        static void AppendUtf8(std::string& out, std::uint32_t codePoint) {
+            if (codePoint < 0x80) {
+                out.push_back(static_cast<char>(codePoint));
+            } else if (codePoint < 0x800) {
+                out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+                out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            } else if (codePoint < 0x10000) {
+                out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            } else {
+                out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+        }
+
+        bool ParseString(std::string& out) {
+            ++m_pos;  // opening quote
+            while (m_pos < m_text.size()) {
+                const char c = m_text[m_pos++];
+                if (c == '"') {
+                    return true;
+                }
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    return Fail("control character in string");
+                }
+                if (c != '\\') {
+                    out.push_back(c);
+                    continue;
+                }
+
+                if (m_pos >= m_text.size()) {
+                    break;
+                }
+                switch (m_text[m_pos++]) {
+                    case '"': out.push_back('"'); break;
+                    case '\\': out.push_back('\\'); break;
+                    case '/': out.push_back('/'); break;
+                    case 'b': out.push_back('\b'); break;
+                    case 'f': out.push_back('\f'); break;
+                    case 'n': out.push_back('\n'); break;
+                    case 'r': out.push_back('\r'); break;
+                    case 't': out.push_back('\t'); break;
+                    case 'u': {
+                        std::uint32_t codePoint = 0;
+                        if (!ParseHex4(codePoint)) {
+                            return false;
+                        }
+                        // A high surrogate must be followed by an escaped low surrogate
+                        if (codePoint >= 0xD800 && codePoint < 0xDC00) {
+                            std::uint32_t low = 0;
+                            if (m_text.substr(m_pos, 2) != "\\u" || (m_pos += 2, !ParseHex4(low)) || low < 0xDC00 ||
+                                low >= 0xE000) {
+                                return Fail("unpaired surrogate in \\u escape");
+                            }
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        }
+                        AppendUtf8(out, codePoint);
+                        break;
+                    }
+                    default:
+                        return Fail("invalid escape in string");
+                }
+            }
+            return Fail("unterminated string");
+        }
+
+        bool ParseNumber(JsonValue& out) {
+            // from_chars accepts the JSON number grammar except for a leading '+', which JSON forbids too,
+            // but also inf/nan/infinity: require a digit up front so those fail like any other bare word
+            const char* first = m_text.data() + m_pos;
+            const char* last = m_text.data() + m_text.size();
+            const char* digit = first != last && *first == '-' ? first + 1 : first;
+            if (digit == last || *digit < '0' || *digit > '9') {
+                return Fail("expected a value");
+            }
+            double value = 0.0;
+            const auto [ptr, ec] = std::from_chars(first, last, value);
+            if (ec != std::errc{} || ptr == first || !std::isfinite(value)) {
+                return Fail("expected a finite number");
+            }
+            out.m_type = JsonValue::Type::Number;
+            out.m_number = value;
+            m_pos += static_cast<std::size_t>(ptr - first);
+            return true;
+        }
+
+        std::string_view m_text;
+        std::size_t m_pos{0};
+        const char* m_error{nullptr};
+        std::size_t m_errorPos{0};
+    };
+
+    std::optional<JsonValue> JsonValue::Parse(std::string_view text, std::string& error) {
+        return JsonParser(text).ParseDocument(error);
+    }
+
+    const JsonValue* JsonValue::Find(std::string_view key) const {
+        if (m_type != Type::Object) {
+            return nullptr;
+        }
+        for (std::size_t i = 0; i < m_keys.size(); ++i) {
+            if (m_keys[i] == key) {
+                return &m_items[i];
+            }
+        }
+        return nullptr;
+    }
+
+}  // namespace KYL
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace KYL {
+
+    // Minimal read-only JSON document for the plugin's small config files; keeps the core free of a
+    // JSON dependency. Objects keep member order, and a duplicate key resolves to its first occurrence.
+    class JsonValue {
+    public:
+        enum class Type { Null, Bool, Number, String, Array, Object };
+
+        // Parse a whole document (UTF-8, optional BOM); on failure error holds "line N: reason"
+        static std::optional<JsonValue> Parse(std::string_view text, std::string& error);
+
+        Type GetType() const { return m_type; }
+        bool IsObject() const { return m_type == Type::Object; }
+        bool IsArray() const { return m_type == Type::Array; }
+
+        // Object member, or nullptr if this is not an object or has no such key
+        const JsonValue* Find(std::string_view key) const;
+
+        // Array elements or object member values
+        const std::vector<JsonValue>& Items() const { return m_items; }
+        // Object member names, parallel to Items()
+        const std::vector<std::string>& Keys() const { return m_keys; }
+
+        // Typed reads; a value of another type yields the fallback
+        double AsNumber(double fallback) const { return m_type == Type::Number ? m_number : fallback; }
+        bool AsBool(bool fallback) const { return m_type == Type::Bool ? m_bool : fallback; }
+        std::string AsString(std::string_view fallback) const {
+            return m_type == Type::String ? m_string : std::string{fallback};
+        }
+
+    private:
+        friend class JsonParser;
+
+        Type m_type{Type::Null};
+        bool m_bool{false};
+        double m_number{0.0};
+        std::string m_string;
+        std::vector<JsonValue> m_items;
+        std::vector<std::string> m_keys;
+    };
+
+}  // namespace KYL
@@ -0,0 +1,167 @@
+#include "LoopLearner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace KYL {
+
+    void LoopLearner::Reset() {
+        m_recordCount = 0;
+        m_tableSize = 0;
+        m_period = 0.0f;
+        m_driftStrikes = 0;
+    }
+
+    bool LoopLearner::Record(std::uint64_t tick, float penetration) {
+        // The period search assumes one sample per tick; a gap (deferral, missing bones) starts over
+        if (m_recordCount > 0 && tick != m_recordStartTick + m_recordCount) {
+            m_recordCount = 0;
+        }
+        if (m_recordCount == 0) {
+            m_recordStartTick = tick;
+        }
+
+        if (m_recordCount == kMaxRecordTicks) {
+            // No period found in a full buffer: keep the newer half and keep listening
+            constexpr std::size_t kKeep = kMaxRecordTicks / 2;
+            std::copy(m_record.end() - kKeep, m_record.end(), m_record.begin());
+            m_recordStartTick += kMaxRecordTicks - kKeep;
+            m_recordCount = kKeep;
+        }
+        m_record[m_recordCount++] = penetration;
+
+        if (m_recordCount < kMinCycles * kMinPeriodTicks || m_recordCount % kSearchEveryTicks != 0) {
+            return false;
+        }
+        if (!TryLearnPeriod()) {
+            return false;
+        }
+
+        m_lastVerifyTick = tick;
+        m_driftStrikes = 0;
+        return true;
+    }
+
+    bool LoopLearner::TryLearnPeriod() {
+        const std::size_t count = m_recordCount;
+        const auto [low, high] = std::minmax_element(m_record.begin(), m_record.begin() + count);
+        const float range = *high - *low;
+        if (range < kMinLoopRange) {
+            return false;
+        }
+        const float tolerance = std::max(0.25f, 0.1f * range);
+
+        // Average magnitude difference per lag: near zero where the recording repeats itself. Every
+        // candidate must fit kMinCycles times; one extra lag is computed to test the last one for a dip.
+        const std::size_t maxLag = count / kMinCycles;
+        std::array<float, kMaxPeriodTicks + 2> difference{};
+        for (std::size_t lag = kMinPeriodTicks - 1; lag <= maxLag + 1 && lag < count; ++lag) {
+            float sum = 0.0f;
+            for (std::size_t i = 0; i + lag < count; ++i) {
+                sum += std::abs(m_record[i + lag] - m_record[i]);
+            }
+            difference[lag] = sum / static_cast<float>(count - lag);
+        }
+
+        // The first dip that matches well is the fundamental period; later dips are its multiples
+        std::size_t lag = kMinPeriodTicks;
+        for (; lag <= maxLag; ++lag) {
+            if (difference[lag] <= 0.5f * tolerance && difference[lag] <= difference[lag - 1] &&
+                difference[lag] <= difference[lag + 1]) {
+                break;
+            }
+        }
+        if (lag > maxLag) {
+            return false;
+        }
+
+        // Loops rarely last a whole number of ticks. The fractional period comes from a V fitted through
+        // the dip at the furthest multiple of the period that still overlaps a full cycle, which divides
+        // the fitting error by the number of cycles spanned.
+        std::size_t cycles = 1;
+        while ((cycles + 1) * lag + 1 + lag <= count) {
+            ++cycles;
+        }
+        const auto differenceAt = [this, count](std::size_t at) {
+            float sum = 0.0f;
+            for (std::size_t i = 0; i + at < count; ++i) {
+                sum += std::abs(m_record[i + at] - m_record[i]);
+            }
+            return sum / static_cast<float>(count - at);
+        };
+        std::size_t dip = cycles * lag;
+        for (const std::size_t candidate : {dip - 1, dip + 1}) {
+            if (differenceAt(candidate) < differenceAt(dip)) {
+                dip = candidate;
+            }
+        }
+        const float before = differenceAt(dip - 1);
+        const float at = differenceAt(dip);
+        const float after = differenceAt(dip + 1);
+        const float slope = std::max(before, after) - at;
+        const float shift = slope > 0.0f ? std::clamp(0.5f * (before - after) / slope, -0.5f, 0.5f) : 0.0f;
+        const float period = (static_cast<float>(dip) + shift) / static_cast<float>(cycles);
+
+        // Fold every recorded sample into its phase bin
+        const auto bins = static_cast<std::size_t>(std::lround(period));
+        std::array<float, kMaxPeriodTicks + 1> sums{};
+        std::array<std::uint16_t, kMaxPeriodTicks + 1> counts{};
+        for (std::size_t i = 0; i < count; ++i) {
+            const float phase = std::fmod(static_cast<float>(i), period) / period;
+            const auto bin = std::min(static_cast<std::size_t>(phase * static_cast<float>(bins)), bins - 1);
+            sums[bin] += m_record[i];
+            ++counts[bin];
+        }
+
+        // Bins no sample landed in (possible with a fractional period) take the previous bin's value
+        std::size_t filled = 0;
+        while (counts[filled] == 0) {
+            ++filled;
+        }
+        float previous = sums[filled] / counts[filled];
+        for (std::size_t bin = 0; bin < bins; ++bin) {
+            const std::size_t at = (filled + bin) % bins;
+            if (counts[at] > 0) {
+                previous = sums[at] / counts[at];
+            }
+            m_table[at] = previous;
+        }
+
+        m_tableSize = bins;
+        m_period = period;
+        m_phaseOriginTick = m_recordStartTick;
+        m_tolerance = tolerance;
+        m_recordCount = 0;
+        return true;
+    }
+
+    float LoopLearner::Sample(std::uint64_t tick) const {
+        // Bin b holds the phases [b, b + 1); interpolate between bin centres
+        const auto elapsed = static_cast<double>(tick - m_phaseOriginTick);
+        const auto bins = static_cast<double>(m_tableSize);
+        double position = std::fmod(elapsed, static_cast<double>(m_period)) / m_period * bins - 0.5;
+        if (position < 0.0) {
+            position += bins;
+        }
+
+        const auto first = static_cast<std::size_t>(position) % m_tableSize;
+        const auto second = (first + 1) % m_tableSize;
+        const auto weight = static_cast<float>(position - std::floor(position));
+        return m_table[first] + (m_table[second] - m_table[first]) * weight;
+    }
+
+    bool LoopLearner::Verify(std::uint64_t tick, float penetration) {
+        m_lastVerifyTick = tick;
+        if (std::abs(penetration - Sample(tick)) <= m_tolerance) {
+            m_driftStrikes = 0;
+            return true;
+        }
+
+        if (++m_driftStrikes < kMaxDriftStrikes) {
+            return true;
+        }
+        Reset();
+        return false;
+    }
+
+}  // namespace KYL
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace KYL {
+
+    // Learns the tip penetration of a looping paired animation as a function of loop phase.
+    // Recording takes one live sample per tick; once at least kMinCycles repetitions are seen, the
+    // period is found from the average magnitude difference of the recording and the samples are
+    // folded into a phase table. Playback then reads the penetration for any tick from the table,
+    // while periodic live checks compare it against the real pose and drop back to recording when
+    // it drifts. Fixed-size storage so learning never allocates on the tick.
+    class LoopLearner {
+    public:
+        static constexpr std::size_t kMaxRecordTicks = 240;
+        static constexpr std::size_t kMinPeriodTicks = 4;
+        static constexpr std::size_t kMinCycles = 3;
+        static constexpr std::size_t kMaxPeriodTicks = kMaxRecordTicks / kMinCycles;
+        // A period search runs whenever this many new samples were recorded
+        static constexpr std::size_t kSearchEveryTicks = 8;
+        // Recordings that barely move are left to live evaluation; a pose at rest is cheap already
+        static constexpr float kMinLoopRange = 0.5f;
+        // Live checks during playback happen at least this often
+        static constexpr std::uint64_t kVerifyIntervalTicks = 4;
+        // Consecutive failed live checks before the table is discarded
+        static constexpr std::uint8_t kMaxDriftStrikes = 2;
+
+        void Reset();
+
+        bool IsPlaying() const { return m_period > 0.0f; }
+        float GetPeriod() const { return m_period; }
+
+        // Recording: feed the live penetration of this tick. A skipped tick restarts the recording.
+        // Returns true when a period was just learned and playback starts.
+        bool Record(std::uint64_t tick, float penetration);
+
+        // Playback: true when this tick should be evaluated live to check for drift
+        bool IsVerifyDue(std::uint64_t tick) const {
+            return m_driftStrikes > 0 || tick - m_lastVerifyTick >= kVerifyIntervalTicks;
+        }
+
+        // Playback: learned penetration at the loop phase of the tick
+        float Sample(std::uint64_t tick) const;
+
+        // Playback: compare a live measurement with the table. Returns false once the pose has drifted
+        // for kMaxDriftStrikes checks in a row; the learner is then back to recording.
+        bool Verify(std::uint64_t tick, float penetration);
+
+    private:
+        bool TryLearnPeriod();
+
+        std::array<float, kMaxRecordTicks> m_record{};
+        std::size_t m_recordCount{0};
+        std::uint64_t m_recordStartTick{0};
+
+        std::array<float, kMaxPeriodTicks + 1> m_table{};
+        std::size_t m_tableSize{0};
+        float m_period{0.0f};
+        std::uint64_t m_phaseOriginTick{0};
+        // Largest difference between table and live pose that still counts as the same loop
+        float m_tolerance{0.0f};
+
+        std::uint64_t m_lastVerifyTick{0};
+        std::uint8_t m_driftStrikes{0};
+    };
+
+}  // namespace KYL
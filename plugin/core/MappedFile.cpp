@@ -0,0 +1,181 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+
+namespace KYL {
+
+    MappedFile::~MappedFile() { Close(); }
+
+#ifdef _WIN32
+
+    bool MappedFile::Open(const std::filesystem::path& path, std::size_t minSize) {
+        Close();
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        m_file = file;
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size)) {
+            Close();
+            return false;
+        }
+        if (!Map(std::max(static_cast<std::size_t>(size.QuadPart), minSize))) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void MappedFile::Close() {
+        Unmap();
+        if (m_file) {
+            CloseHandle(static_cast<HANDLE>(m_file));
+            m_file = nullptr;
+        }
+    }
+
+    bool MappedFile::Resize(std::size_t size) {
+        if (!m_file) {
+            return false;
+        }
+        Unmap();
+
+        // A mapping cannot shrink its file; truncate explicitly, growth happens when mapping
+        LARGE_INTEGER end{};
+        end.QuadPart = static_cast<LONGLONG>(size);
+        const auto file = static_cast<HANDLE>(m_file);
+        if (!SetFilePointerEx(file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+            return false;
+        }
+        return Map(size);
+    }
+
+    void MappedFile::FlushAsync() {
+        // Starts the write of dirty pages; FlushFileBuffers would wait for the disk
+        if (m_data) {
+            FlushViewOfFile(m_data, 0);
+        }
+    }
+
+    bool MappedFile::Map(std::size_t size) {
+        const auto high = static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32);
+        const auto low = static_cast<DWORD>(size & 0xFFFFFFFFu);
+        const HANDLE mapping =
+            CreateFileMappingW(static_cast<HANDLE>(m_file), nullptr, PAGE_READWRITE, high, low, nullptr);
+        if (!mapping) {
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (!view) {
+            CloseHandle(mapping);
+            return false;
+        }
+        m_mapping = mapping;
+        m_data = static_cast<std::byte*>(view);
+        m_size = size;
+        return true;
+    }
+
+    void MappedFile::Unmap() {
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+            m_data = nullptr;
+        }
+        if (m_mapping) {
+            CloseHandle(static_cast<HANDLE>(m_mapping));
+            m_mapping = nullptr;
+        }
+        m_size = 0;
+    }
+
+#else
+
+    bool MappedFile::Open(const std::filesystem::path& path, std::size_t minSize) {
+        Close();
+        m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (m_fd < 0) {
+            return false;
+        }
+
+        struct stat info{};
+        if (::fstat(m_fd, &info) != 0) {
+            Close();
+            return false;
+        }
+        const auto size = std::max(static_cast<std::size_t>(info.st_size), minSize);
+        if (static_cast<std::size_t>(info.st_size) < size && ::ftruncate(m_fd, static_cast<off_t>(size)) != 0) {
+            Close();
+            return false;
+        }
+        if (!Map(size)) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void MappedFile::Close() {
+        Unmap();
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    bool MappedFile::Resize(std::size_t size) {
+        if (m_fd < 0) {
+            return false;
+        }
+        Unmap();
+        if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0) {
+            return false;
+        }
+        return Map(size);
+    }
+
+    void MappedFile::FlushAsync() {
+        if (m_data) {
+            ::msync(m_data, m_size, MS_ASYNC);
+        }
+    }
+
+    bool MappedFile::Map(std::size_t size) {
+        void* view = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (view == MAP_FAILED) {
+            return false;
+        }
+        m_data = static_cast<std::byte*>(view);
+        m_size = size;
+        return true;
+    }
+
+    void MappedFile::Unmap() {
+        if (m_data) {
+            ::munmap(m_data, m_size);
+            m_data = nullptr;
+        }
+        m_size = 0;
+    }
+
+#endif
+
+}  // namespace KYL
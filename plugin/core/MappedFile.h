@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace KYL {
+
+    // Read/write shared mapping of a whole file. Writes through Data() land in the OS page cache and
+    // reach the disk even if the process dies without closing; FlushAsync only starts the write-back.
+    // Not thread-safe: Resize and Close invalidate Data().
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Open or create the file and map it, growing it to at least minSize bytes
+        bool Open(const std::filesystem::path& path, std::size_t minSize);
+        void Close();
+
+        // Remap with the file grown or shrunk to size bytes; contents up to the smaller size are kept
+        bool Resize(std::size_t size);
+
+        // Queue dirty pages for writing without waiting for the disk
+        void FlushAsync();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        std::byte* Data() const { return m_data; }
+        std::size_t Size() const { return m_size; }
+
+    private:
+        bool Map(std::size_t size);
+        void Unmap();
+
+        std::byte* m_data{nullptr};
+        std::size_t m_size{0};
+#ifdef _WIN32
+        void* m_file{nullptr};
+        void* m_mapping{nullptr};
+#else
+        int m_fd{-1};
+#endif
+    };
+
+}  // namespace KYL
@@ -0,0 +1,1407 @@
+#include "MonitorEngine.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <numeric>
+#include <cmath>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+
+#include <fmt/format.h>
+
+#include "AllocationCounter.h"
+#include "Logger.h"
+#include "Tracer.h"
+
+namespace KYL {
+
+    namespace {
+        std::string_view GetNodeLabel(const std::string& nodeName) {
+            return nodeName.empty() ? std::string_view{"<empty>"} : std::string_view{nodeName};
+        }
+
+        std::string JoinNodeLabels(const std::vector<std::string>& nodeNames) {
+            std::string result;
+            for (std::size_t i = 0; i < nodeNames.size(); ++i) {
+                if (i > 0) {
+                    result.append(", ");
+                }
+                const auto label = GetNodeLabel(nodeNames[i]);
+                result.append(label.data(), label.size());
+            }
+            return result;
+        }
+
+        // Volume monitors measure overlap rather than tip depth, so what they learn is filed per volume
+        std::string GetCalibrationTarget(const MonitorSpec& spec) {
+            if (!spec.volume.IsEnabled()) {
+                return spec.targetNode;
+            }
+            return fmt::format("{}|{}|{:g}|{:g}", spec.targetNode, spec.volume.targetEndNode, spec.volume.probeRadius,
+                               spec.volume.targetRadius);
+        }
+
+        // Ticks until a monitor at penetration needs another look. Above the shrink threshold any rise can
+        // set a new maximum, so it stays at full rate; otherwise it waits half the time the tip needs, at
+        // its recent peak speed, to get within the prediction look-ahead of a threshold whose crossing
+        // would change something.
+        std::uint32_t NextEvalInterval(float penetration, const MonitorStore::PenetrationHistory& history,
+                                       float lookAheadTicks, float distanceThreshold, float restoreThreshold,
+                                       bool bonesMoved, std::uint32_t maxInterval) {
+            if (maxInterval <= 1 || penetration > distanceThreshold || history.count < 2) {
+                return 1;
+            }
+
+            float margin = distanceThreshold - penetration;
+            if (bonesMoved && penetration > restoreThreshold) {
+                margin = std::min(margin, penetration - restoreThreshold);
+            }
+            if (margin < kEvalNearMargin) {
+                return 1;
+            }
+
+            const float speed = history.PeakSpeed();
+            const float ticks = 0.5f * (margin / std::max(speed, 1e-4f) - lookAheadTicks);
+            return static_cast<std::uint32_t>(std::clamp(ticks, 1.0f, static_cast<float>(maxInterval)));
+        }
+    }
+
+    MonitorEngine::ChainUpdate::ChainUpdate(ISkeleton& skeleton) : m_skeleton(skeleton) {}
+
+    MonitorEngine::ChainUpdate::~ChainUpdate() { Flush(); }
+
+    void MonitorEngine::ChainUpdate::MarkDirty(NodeRef node) {
+        if (node && m_count < m_dirty.size()) {
+            m_dirty[m_count++] = node;
+        }
+    }
+
+    bool MonitorEngine::ChainUpdate::HasDirtyAncestor(NodeRef node) {
+        for (auto parent = m_skeleton.GetParent(node); parent; parent = m_skeleton.GetParent(parent)) {
+            if (std::find(m_dirty.begin(), m_dirty.begin() + m_count, parent) != m_dirty.begin() + m_count) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void MonitorEngine::ChainUpdate::Flush() {
+        // A subtree update from a dirty node already covers every dirty node below it, so only the
+        // topmost dirty nodes are updated: one call for a nested chain instead of one per bone
+        for (std::size_t i = 0; i < m_count; ++i) {
+            if (!HasDirtyAncestor(m_dirty[i])) {
+                KYL_TRACE_SPAN("UpdateWorldData");
+                m_skeleton.UpdateWorldData(m_dirty[i]);
+            }
+        }
+        m_count = 0;
+    }
+
+    void MonitorEngine::GatherBuffers::Clear() {
+        monitorIndices.clear();
+        presentMasks.clear();
+        for (auto* array : {&baseX, &baseY, &baseZ, &tipX, &tipY, &tipZ, &targetX, &targetY, &targetZ}) {
+            array->clear();
+        }
+    }
+
+    void MonitorEngine::GatherBuffers::Reserve(std::size_t count) {
+        monitorIndices.reserve(count);
+        presentMasks.reserve(count);
+        for (auto* array : {&baseX, &baseY, &baseZ, &tipX, &tipY, &tipZ, &targetX, &targetY, &targetZ, &directionX,
+                            &directionY, &directionZ, &probeLength, &tipPenetration}) {
+            array->reserve(count);
+        }
+    }
+
+    void MonitorEngine::GatherBuffers::Push(std::uint32_t monitorIdx, MonitorStore::BoneMask presentMask,
+                                            const Vector3& base, const Vector3& tip, const Vector3& target) {
+        monitorIndices.push_back(monitorIdx);
+        presentMasks.push_back(presentMask);
+        baseX.push_back(base.x);
+        baseY.push_back(base.y);
+        baseZ.push_back(base.z);
+        tipX.push_back(tip.x);
+        tipY.push_back(tip.y);
+        tipZ.push_back(tip.z);
+        targetX.push_back(target.x);
+        targetY.push_back(target.y);
+        targetZ.push_back(target.z);
+    }
+
+    PenetrationBatch MonitorEngine::GatherBuffers::Batch() {
+        const std::size_t count = monitorIndices.size();
+        for (auto* array : {&directionX, &directionY, &directionZ, &probeLength, &tipPenetration}) {
+            array->resize(count);
+        }
+
+        PenetrationBatch batch;
+        batch.count = count;
+        batch.baseX = baseX.data();
+        batch.baseY = baseY.data();
+        batch.baseZ = baseZ.data();
+        batch.tipX = tipX.data();
+        batch.tipY = tipY.data();
+        batch.tipZ = tipZ.data();
+        batch.targetX = targetX.data();
+        batch.targetY = targetY.data();
+        batch.targetZ = targetZ.data();
+        batch.directionX = directionX.data();
+        batch.directionY = directionY.data();
+        batch.directionZ = directionZ.data();
+        batch.probeLength = probeLength.data();
+        batch.tipPenetration = tipPenetration.data();
+        return batch;
+    }
+
+    void MonitorEngine::RestoreBonePosition(NodeIndex::ActorNodes& actor, NodeIndex::NameId name,
+                                            ChainUpdate& update) {
+        KYL_TRACE_SPAN("RestoreBonePosition");
+        auto node = m_nodeIndex.Resolve(actor, name);
+        const auto& nodeName = m_nodeIndex.GetName(name);
+
+        if (!node) {
+            LOG_WARN("RestoreBone: bone {} not found on actor {}", nodeName,
+                     m_skeleton.GetActorName(actor.Handle()));
+            return;
+        }
+
+        LOG_TRACE("RestoreBone: {} restoring to originalY={:.3f}", nodeName, 0.0f);
+
+        m_skeleton.SetLocalTranslate(node, Vector3{0.0f, 0.0f, 0.0f});
+        ++m_boneWrites;
+        update.MarkDirty(node);
+    }
+
+    void MonitorEngine::RestoreMiddleBonesForEntry(std::size_t index) {
+        const auto probeHandle = m_store.probeHandles[index];
+        if (!m_skeleton.IsActorValid(probeHandle)) {
+            return;
+        }
+
+        const auto& probeNodes = m_store.metadata[index].probeNodes;
+        const auto movedMask = m_store.movedMasks[index];
+        auto& actorNodes = m_nodeIndex.ForActor(probeHandle);
+        ChainUpdate update(m_skeleton);
+        for (std::size_t idx = 1; idx < probeNodes.size() - 1; ++idx) {
+            if (MonitorStore::IsMoved(movedMask, idx)) {
+                RestoreBonePosition(actorNodes, m_store.ChainName(index, idx), update);
+                LOG_TRACE("Restored bone {} for actor {}", GetNodeLabel(probeNodes[idx]),
+                          m_skeleton.GetActorName(probeHandle));
+            }
+        }
+    }
+
+    void MonitorEngine::ReleaseBonesForEntry(std::size_t index) {
+        bool shared = false;
+        for (std::size_t i = 0; i < m_store.Size(); ++i) {
+            if (i != index && m_store.SharesProbeChain(i, index)) {
+                m_store.nextEvalTicks[i] = 0;
+                shared = true;
+            }
+        }
+        if (!shared) {
+            RestoreMiddleBonesForEntry(index);
+        }
+    }
+
+    void MonitorEngine::MoveBoneToTarget(NodeIndex::ActorNodes& actor, NodeIndex::NameId name,
+                                         float penetrationDepth, ChainUpdate& update) {
+        KYL_TRACE_SPAN("MoveBoneToTarget");
+        auto node = m_nodeIndex.Resolve(actor, name);
+        const auto& nodeName = m_nodeIndex.GetName(name);
+
+        if (!node) {
+            LOG_WARN("MoveBone: bone {} not found on actor {}", nodeName, m_skeleton.GetActorName(actor.Handle()));
+            return;
+        }
+        // Calculate how much to move the bone backwards along Y axis
+        // penetrationDepth is how far beyond threshold the bone has gone, in world units; the translate is
+        // in the parent's space, so divide out the scale actor and genital size scaling put on it
+        const auto parent = m_skeleton.GetParent(node);
+        const float parentScale = parent ? m_skeleton.GetWorldScale(parent) : 1.0f;
+        const float yOffset = parentScale > 1e-4f ? -penetrationDepth / parentScale : -penetrationDepth;
+
+        // Apply offset to ORIGINAL position, not current position
+        Vector3 newPos{0.0f, 0.0f, 0.0f};
+        newPos.y += yOffset;
+
+        // Check if bone is already at target position (within tolerance)
+        const float currentY = m_skeleton.GetLocalTranslate(node).y;
+        const float deltaY = std::abs(currentY - newPos.y);
+
+        if (deltaY < kPositionTolerance) {
+            // Already at target position, no need to update
+            return;
+        }
+
+        LOG_TRACE("MoveBone: {} originalY={:.3f} offset={:.3f} newY={:.3f}", nodeName, 0.0f, yOffset, newPos.y);
+
+        m_skeleton.SetLocalTranslate(node, newPos);
+        ++m_boneWrites;
+        update.MarkDirty(node);
+    }
+
+    MonitorEngine::ConsumerScope::ConsumerScope(std::atomic<bool>& flag, bool wait) : m_flag(flag) {
+        while (!(m_owned = !m_flag.exchange(true, std::memory_order_acquire)) && wait) {
+            std::this_thread::yield();
+        }
+    }
+
+    MonitorEngine::ConsumerScope::~ConsumerScope() {
+        if (m_owned) {
+            m_flag.store(false, std::memory_order_release);
+        }
+    }
+
+    CommandTicket MonitorEngine::Submit(Command command) {
+        command.ticket = m_nextTicket.fetch_add(1, std::memory_order_relaxed) + 1;
+        const auto ticket = command.ticket;
+        m_commands.Push(std::move(command));
+        return ticket;
+    }
+
+    bool MonitorEngine::IsValidSpec(const MonitorSpec& spec) {
+        if (spec.probeNodes.empty()) {
+            LOG_WARN("AddMonitor rejected empty probe node list.");
+            return false;
+        }
+
+        // Monitors created by AddMonitor run indefinitely until stopped.
+        // Don't clamp thresholds - allow negative values for pre-emptive scaling
+        if (spec.probeHandle == 0 || spec.targetHandle == 0) {
+            LOG_WARN("AddMonitor received actor with invalid handle (probe={}, target={})", spec.probeHandle,
+                     spec.targetHandle);
+            return false;
+        }
+
+        if (spec.probeNodes.size() > MonitorStore::kMaxChainLength) {
+            LOG_WARN("AddMonitor rejected probe chain of {} nodes (max {}).", spec.probeNodes.size(),
+                     MonitorStore::kMaxChainLength);
+            return false;
+        }
+
+        const auto& volume = spec.volume;
+        if (!std::isfinite(volume.probeRadius) || !std::isfinite(volume.targetRadius) || volume.probeRadius < 0.0f ||
+            volume.targetRadius < 0.0f) {
+            LOG_WARN("AddMonitor rejected volume radii {:.2f}/{:.2f}.", volume.probeRadius, volume.targetRadius);
+            return false;
+        }
+        return true;
+    }
+
+    MonitorEngine::AddRequest MonitorEngine::MakeAddRequest(MonitorSpec spec) {
+        AddRequest request;
+        // Looked up on the caller's thread so the tick never waits for the cache
+        if (auto* cache = m_calibration.load(std::memory_order_acquire); cache && !spec.calibrationKey.empty()) {
+            request.calibrationKey =
+                CalibrationCache::MakeKey(spec.calibrationKey, GetCalibrationTarget(spec), spec.probeNodes);
+            request.calibration = cache->Find(request.calibrationKey);
+        }
+        request.spec = std::move(spec);
+        return request;
+    }
+
+    CommandTicket MonitorEngine::AddMonitor(MonitorSpec spec) {
+        KYL_TRACE_SPAN("AddMonitor");
+        if (!IsValidSpec(spec)) {
+            return 0;
+        }
+
+        Command command;
+        command.type = Command::Type::Add;
+        command.adds.push_back(MakeAddRequest(std::move(spec)));
+        return Submit(std::move(command));
+    }
+
+    CommandTicket MonitorEngine::AddMonitors(std::vector<MonitorSpec> specs) {
+        KYL_TRACE_SPAN("AddMonitors");
+        Command command;
+        command.type = Command::Type::Add;
+        command.adds.reserve(specs.size());
+        for (auto& spec : specs) {
+            if (IsValidSpec(spec)) {
+                command.adds.push_back(MakeAddRequest(std::move(spec)));
+            }
+        }
+        return command.adds.empty() ? 0 : Submit(std::move(command));
+    }
+
+    CommandTicket MonitorEngine::ApplyMonitorSet(std::vector<ActorHandle> actors, std::vector<MonitorSpec> specs) {
+        KYL_TRACE_SPAN("ApplyMonitorSet");
+        Command command;
+        command.type = Command::Type::Replace;
+        command.adds.reserve(specs.size());
+        for (auto& spec : specs) {
+            if (IsValidSpec(spec)) {
+                actors.push_back(spec.probeHandle);
+                actors.push_back(spec.targetHandle);
+                command.adds.push_back(MakeAddRequest(std::move(spec)));
+            }
+        }
+        if (actors.empty()) {
+            return 0;
+        }
+        command.handles = std::move(actors);
+        return Submit(std::move(command));
+    }
+
+    CommandTicket MonitorEngine::RemoveMonitors(std::vector<ActorHandle> handles) {
+        KYL_TRACE_SPAN("RemoveMonitors");
+        Command command;
+        command.type = Command::Type::Remove;
+        command.handles = std::move(handles);
+        return Submit(std::move(command));
+    }
+
+    void MonitorEngine::InvalidateActor(ActorHandle actor) {
+        Command command;
+        command.type = Command::Type::InvalidateActor;
+        command.handles.push_back(actor);
+        Submit(std::move(command));
+    }
+
+    bool MonitorEngine::ApplyAddRequest(const AddRequest& request, CommandTicket ticket) {
+        const auto& spec = request.spec;
+        MonitorStore::Metadata metadata{spec.probeNodes, spec.targetNode, spec.volume, 0.0f, request.calibrationKey};
+
+        std::vector<NodeIndex::NameId> chain;
+        chain.reserve(spec.probeNodes.size());
+        for (const auto& name : spec.probeNodes) {
+            chain.push_back(m_nodeIndex.Intern(name));
+        }
+        const auto targetName = m_nodeIndex.Intern(spec.targetNode);
+
+        MonitorStore::Volume volume;
+        if (spec.volume.IsEnabled()) {
+            volume.probeRadius = spec.volume.probeRadius;
+            volume.targetRadius = spec.volume.targetRadius;
+            volume.enabled = true;
+            volume.capsule = !spec.volume.targetEndNode.empty();
+            if (volume.capsule) {
+                volume.targetEnd = m_nodeIndex.Intern(spec.volume.targetEndNode);
+            }
+        }
+
+        bool updated = false;
+        std::size_t index = 0;
+        if (const auto existing = m_store.Find(spec.probeHandle, spec.targetHandle, spec.targetNode)) {
+            index = *existing;
+            SaveCalibration(index);
+            if (!m_store.HasProbeChain(index, chain)) {
+                // The moved mask indexes the old chain; put its bones back while their names are known
+                ReleaseBonesForEntry(index);
+                m_store.movedMasks[index] = 0;
+                m_store.appliedCorrections[index] = 0.0f;
+                m_store.requestedPullbacks[index] = 0.0f;
+            }
+            m_store.Reset(index, std::move(metadata), chain, targetName, spec.distanceThreshold,
+                          spec.restoreThreshold, volume);
+            updated = true;
+        } else {
+            index = m_store.Add(spec.probeHandle, spec.targetHandle, std::move(metadata), chain, targetName,
+                                spec.distanceThreshold, spec.restoreThreshold, volume);
+        }
+
+        if (const auto& seed = request.calibration) {
+            // Start from what this scene taught last time. The peak behind the maximum beyond the
+            // threshold does not depend on the threshold, so it carries over a changed one.
+            m_store.metadata[index].maxPenetration = seed->maxPenetration;
+            if (seed->maxPenetrationBeyondThreshold > 0.0f) {
+                m_store.maxPenetrationBeyondThreshold[index] = std::max(
+                    seed->maxPenetrationBeyondThreshold + seed->distanceThreshold - spec.distanceThreshold, 0.0f);
+            }
+            LOG_DEBUG("#{} Seeded from calibration cache (max penetration {:.3f}, beyond threshold {:.3f})",
+                      ticket, seed->maxPenetration, m_store.maxPenetrationBeyondThreshold[index]);
+        }
+
+        return updated;
+    }
+
+    void MonitorEngine::ApplyAdd(const Command& command) {
+        // A batch is summarized in one line; its monitors are only listed at debug level
+        if (command.adds.size() > 1) {
+            std::size_t updated = 0;
+            for (const auto& request : command.adds) {
+                const bool wasUpdated = ApplyAddRequest(request, command.ticket);
+                updated += wasUpdated ? 1 : 0;
+                const auto& spec = request.spec;
+                LOG_DEBUG("#{} {} bone monitor for {}.[{}] -> {}.{} (shrink threshold {:.2f}, restore threshold {:.2f})",
+                          command.ticket, wasUpdated ? "Updated" : "Created", m_skeleton.GetActorName(spec.probeHandle),
+                          JoinNodeLabels(spec.probeNodes), m_skeleton.GetActorName(spec.targetHandle),
+                          GetNodeLabel(spec.targetNode), spec.distanceThreshold, spec.restoreThreshold);
+            }
+            LOG_INFO("#{} Registered {} bone monitor(s) ({} created, {} updated), {} active", command.ticket,
+                     command.adds.size(), command.adds.size() - updated, updated, m_store.Size());
+            return;
+        }
+
+        const auto& spec = command.adds.front().spec;
+        const bool updated = ApplyAddRequest(command.adds.front(), command.ticket);
+        LOG_INFO(
+            "#{} {} bone monitor for {}.[{}] -> {}.{} (shrink threshold {:.2f}, restore threshold {:.2f}, lifetime "
+            "indefinite)",
+            command.ticket, updated ? "Updated" : "Created", m_skeleton.GetActorName(spec.probeHandle),
+            JoinNodeLabels(spec.probeNodes), m_skeleton.GetActorName(spec.targetHandle), GetNodeLabel(spec.targetNode),
+            spec.distanceThreshold, spec.restoreThreshold);
+    }
+
+    void MonitorEngine::ApplyRemove(const Command& command) {
+        const auto& handles = command.handles;
+        std::size_t removed = 0;
+
+        if (handles.empty()) {
+            // Restore all bones before clearing all monitors
+            for (std::size_t i = 0; i < m_store.Size(); ++i) {
+                SaveCalibration(i);
+                RestoreMiddleBonesForEntry(i);
+            }
+            removed = m_store.Size();
+            m_store.Clear();
+        } else {
+            // Use a set for O(1) lookup instead of O(n) linear search
+            const std::set<ActorHandle> handleSet(handles.begin(), handles.end());
+
+            // Walk backwards so removal keeps the remaining slot indices valid
+            for (std::size_t i = m_store.Size(); i-- > 0;) {
+                if (handleSet.contains(m_store.probeHandles[i]) || handleSet.contains(m_store.targetHandles[i])) {
+                    SaveCalibration(i);
+                    ReleaseBonesForEntry(i);
+                    m_store.Remove(i);
+                    ++removed;
+                }
+            }
+        }
+
+        if (removed == 0) {
+            if (handles.empty()) {
+                LOG_WARN("#{} Stop: no active monitors.", command.ticket);
+            } else {
+                LOG_WARN("#{} Stop: no monitors matched {} actor(s).", command.ticket, handles.size());
+            }
+        } else if (handles.empty()) {
+            LOG_INFO("#{} Stopped all {} monitor(s).", command.ticket, removed);
+        } else {
+            LOG_INFO("#{} Stopped {} monitor(s) for {} actor(s), {} remaining.", command.ticket, removed,
+                     handles.size(), m_store.Size());
+        }
+    }
+
+    std::size_t MonitorEngine::ApplyReplace(const Command& command) {
+        const std::set<ActorHandle> scope(command.handles.begin(), command.handles.end());
+        const auto isDesired = [&command](ActorHandle probe, ActorHandle target, const std::string& targetNode) {
+            return std::any_of(command.adds.begin(), command.adds.end(), [&](const AddRequest& request) {
+                return request.spec.probeHandle == probe && request.spec.targetHandle == target &&
+                       request.spec.targetNode == targetNode;
+            });
+        };
+
+        // Only monitors leaving the set give their bones back
+        std::size_t removed = 0;
+        for (std::size_t i = m_store.Size(); i-- > 0;) {
+            if ((scope.contains(m_store.probeHandles[i]) || scope.contains(m_store.targetHandles[i])) &&
+                !isDesired(m_store.probeHandles[i], m_store.targetHandles[i], m_store.metadata[i].targetNode)) {
+                SaveCalibration(i);
+                ReleaseBonesForEntry(i);
+                m_store.Remove(i);
+                ++removed;
+            }
+        }
+
+        std::size_t kept = 0;
+        std::size_t changed = 0;
+        for (const auto& request : command.adds) {
+            const auto& spec = request.spec;
+            const auto existing = m_store.Find(spec.probeHandle, spec.targetHandle, spec.targetNode);
+            // A changed volume changes what the thresholds and learned maxima measure
+            if (!existing || m_store.metadata[*existing].probeNodes != spec.probeNodes ||
+                m_store.metadata[*existing].volume != spec.volume) {
+                changed += ApplyAddRequest(request, command.ticket) ? 1 : 0;
+                continue;
+            }
+
+            // Same pair and chain: keep nodes, moved bones and learned maxima, retune thresholds in place.
+            // The peak behind the maximum beyond the threshold does not depend on the threshold.
+            const auto index = *existing;
+            auto& maxBeyond = m_store.maxPenetrationBeyondThreshold[index];
+            if (maxBeyond > 0.0f) {
+                maxBeyond = std::max(maxBeyond + m_store.distanceThresholds[index] - spec.distanceThreshold, 0.0f);
+            }
+            m_store.distanceThresholds[index] = spec.distanceThreshold;
+            m_store.restoreThresholds[index] = spec.restoreThreshold;
+
+            if (m_store.metadata[index].calibrationKey != request.calibrationKey) {
+                // New scene: file what was learned under the old one and relearn the animation loop
+                SaveCalibration(index);
+                m_store.metadata[index].calibrationKey = request.calibrationKey;
+                m_store.ResetMotion(index);
+            }
+            ++kept;
+        }
+
+        const auto created = command.adds.size() - kept - changed;
+        LOG_INFO("#{} Applied monitor set for {} actor(s): {} kept, {} created, {} reset, {} removed, {} active",
+                 command.ticket, scope.size(), kept, created, changed, removed, m_store.Size());
+        return removed;
+    }
+
+    void MonitorEngine::ApplyInvalidate(ActorHandle actor) {
+        m_nodeIndex.Invalidate(actor);
+
+        // The new 3D starts from its authored pose; forget offsets written to the old nodes
+        for (std::size_t i = 0; i < m_store.Size(); ++i) {
+            if (m_store.probeHandles[i] == actor || m_store.targetHandles[i] == actor) {
+                m_store.ResetMotion(i);
+            }
+            if (m_store.probeHandles[i] == actor) {
+                m_store.movedMasks[i] = 0;
+                m_store.appliedCorrections[i] = 0.0f;
+                m_store.requestedPullbacks[i] = 0.0f;
+                m_store.engaged[i] = 0;
+                m_store.restMasks[i] = 0;
+                m_store.chainSpans[i] = 0.0f;
+                m_store.maxPenetrationBeyondThreshold[i] = 0.0f;
+            }
+        }
+        LOG_DEBUG("Node index invalidated for {}", m_skeleton.GetActorName(actor));
+    }
+
+    void MonitorEngine::SaveCalibration(std::size_t index) {
+        auto* cache = m_calibration.load(std::memory_order_acquire);
+        const auto key = m_store.metadata[index].calibrationKey;
+        if (!cache || key == 0) {
+            return;
+        }
+        // Queued for the cache's writer thread; never blocks the tick
+        cache->Store(key, Calibration{m_store.metadata[index].maxPenetration,
+                                      m_store.maxPenetrationBeyondThreshold[index], m_store.distanceThresholds[index]});
+    }
+
+    void MonitorEngine::PruneNodeIndex() {
+        std::unordered_set<ActorHandle> referenced(m_store.probeHandles.begin(), m_store.probeHandles.end());
+        referenced.insert(m_store.targetHandles.begin(), m_store.targetHandles.end());
+        m_nodeIndex.Prune([&referenced](ActorHandle actor) { return referenced.contains(actor); });
+        std::fill(m_store.probeNodes.begin(), m_store.probeNodes.end(), nullptr);
+        std::fill(m_store.targetNodes.begin(), m_store.targetNodes.end(), nullptr);
+    }
+
+    void MonitorEngine::SyncLoopLearners() {
+        const bool enabled = m_loopLearning.load(std::memory_order_relaxed);
+        if (enabled == m_loopLearningActive && !m_registryChanged) {
+            return;
+        }
+
+        // Learners are allocated here rather than inside the pass so a steady-state tick never does;
+        // the tick that switches the mode is not steady-state
+        if (enabled != m_loopLearningActive) {
+            LOG_INFO("Loop learning {}", enabled ? "enabled" : "disabled");
+            m_loopLearningActive = enabled;
+            m_registryChanged = true;
+        }
+        for (auto& learner : m_store.loopLearners) {
+            if (!enabled) {
+                learner.reset();
+            } else if (!learner) {
+                learner = std::make_unique<LoopLearner>();
+            }
+        }
+    }
+
+    void MonitorEngine::ApplyCommands() {
+        KYL_TRACE_SPAN("ApplyCommands");
+        Command command;
+        bool removed = false;
+        while (m_commands.TryPop(command)) {
+            switch (command.type) {
+                case Command::Type::Add:
+                    ApplyAdd(command);
+                    m_registryChanged = true;
+                    break;
+                case Command::Type::Remove:
+                    ApplyRemove(command);
+                    m_registryChanged = true;
+                    removed = true;
+                    break;
+                case Command::Type::Replace:
+                    removed = ApplyReplace(command) > 0 || removed;
+                    m_registryChanged = true;
+                    break;
+                case Command::Type::InvalidateActor:
+                    ApplyInvalidate(command.handles.front());
+                    break;
+            }
+        }
+
+        if (removed) {
+            PruneNodeIndex();
+        }
+        m_size.store(m_store.Size(), std::memory_order_relaxed);
+    }
+
+    std::size_t MonitorEngine::Clear() {
+        const ConsumerScope consumer(m_consuming, true);
+
+        // Requests queued before the reset are stale
+        Command discarded;
+        while (m_commands.TryPop(discarded)) {
+        }
+
+        const auto count = m_store.Size();
+
+        // Restore all moved bones to their original positions
+        for (std::size_t i = 0; i < count; ++i) {
+            SaveCalibration(i);
+            RestoreMiddleBonesForEntry(i);
+        }
+
+        m_store.Clear();
+        m_nodeIndex.Clear();
+        m_registryChanged = true;
+        m_size.store(0, std::memory_order_relaxed);
+        return count;
+    }
+
+    void MonitorEngine::SetLookAheadTicks(float ticks) {
+        const float clamped = std::isfinite(ticks) ? std::clamp(ticks, 0.0f, kMaxLookAheadTicks) : 0.0f;
+        m_lookAheadTicks.store(clamped, std::memory_order_relaxed);
+    }
+
+    bool MonitorEngine::HasPendingCommands() const { return !m_commands.Empty(); }
+
+    std::size_t MonitorEngine::Size() const { return m_size.load(std::memory_order_relaxed); }
+
+    TickAllocationStats MonitorEngine::GetAllocationStats() const { return m_allocationStats; }
+
+    void MonitorEngine::ResetAllocationStats() { m_allocationStats = {}; }
+
+    bool MonitorEngine::Tick() {
+        KYL_TRACE_SPAN("Tick");
+        const ConsumerScope consumer(m_consuming, false);
+        if (!consumer) {
+            // Clear is resetting the registry; the next tick picks up whatever remains
+            return true;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint64_t writesBefore = m_boneWrites;
+        const std::uint64_t missesBefore = m_nodeIndex.GetMissCount();
+        const std::uint64_t evaluatedBefore = m_evaluationStats.evaluated;
+
+        ApplyCommands();
+        if (m_store.Empty()) {
+            return false;
+        }
+        SyncLoopLearners();
+        if (m_registryChanged) {
+            // The split between live and played-back monitors shifts from tick to tick as loops are
+            // learned and dropped; size both for the whole registry up front
+            m_gather.Reserve(m_store.Size());
+            m_playback.reserve(m_store.Size());
+            m_pendingSamples.reserve(m_store.Size());
+            m_chainPoints.reserve(m_store.chainNames.size());
+            m_removeScratch.reserve(m_store.Size());
+            RebuildProbeGroups();
+        }
+
+        const AllocationScope allocations;
+        const bool steadyState = !m_registryChanged;
+        m_registryChanged = false;
+
+        const bool active = RunPass();
+        m_size.store(m_store.Size(), std::memory_order_relaxed);
+
+        const auto elapsedNs = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        const std::uint64_t evaluated = m_evaluationStats.evaluated - evaluatedBefore;
+        m_metrics.tickUs.Record(elapsedNs / 1000);
+        if (evaluated > 0) {
+            m_metrics.monitorNs.Record(elapsedNs / evaluated);
+        }
+        m_metrics.boneWrites.Record(m_boneWrites - writesBefore);
+        m_metrics.nodeMisses.Record(m_nodeIndex.GetMissCount() - missesBefore);
+
+        if (steadyState && !m_registryChanged) {
+            ++m_allocationStats.steadyTicks;
+            if (const auto count = allocations.Count(); count > 0) {
+                ++m_allocationStats.ticksWithAllocations;
+                m_allocationStats.allocations += count;
+                LOG_DEBUG("Steady-state tick made {} heap allocation(s) ({} monitors)", count, m_store.Size());
+            }
+        }
+
+        if (!active && AllocationScope::IsEnabled()) {
+            LOG_INFO("Tick allocations: {} over {} steady-state tick(s), {} tick(s) allocated",
+                     m_allocationStats.allocations, m_allocationStats.steadyTicks,
+                     m_allocationStats.ticksWithAllocations);
+        }
+        return active;
+    }
+
+    bool MonitorEngine::RunPass() {
+        KYL_TRACE_SPAN("RunPass");
+        // Track which monitors to remove
+        auto& monitorsToRemove = m_removeScratch;
+        monitorsToRemove.clear();
+        m_gather.Clear();
+        m_playback.clear();
+        m_pendingSamples.clear();
+        m_chainPoints.clear();
+        m_groups.queued.clear();
+        m_nodeIndex.BeginTick();
+        auto* recorder = m_recorder.load(std::memory_order_acquire);
+        if (recorder && !recorder->IsRecording()) {
+            recorder = nullptr;
+        }
+        const PassContext pass{++m_tickCount, m_lookAheadTicks.load(std::memory_order_relaxed),
+                               m_maxEvalInterval.load(std::memory_order_relaxed), recorder,
+                               recorder ? recorder->ElapsedMicros() : 0};
+        const std::uint64_t tick = pass.tick;
+        ++m_evaluationStats.ticks;
+
+        for (std::size_t monitorIdx = 0; monitorIdx < m_store.Size(); ++monitorIdx) {
+            // Not due yet: far enough from its thresholds that nothing can change before then
+            if (tick < m_store.nextEvalTicks[monitorIdx]) {
+                ++m_evaluationStats.deferred;
+                continue;
+            }
+            ++m_evaluationStats.evaluated;
+
+            const auto probeHandle = m_store.probeHandles[monitorIdx];
+            const auto targetHandle = m_store.targetHandles[monitorIdx];
+            const std::size_t chainLength = m_store.chainLengths[monitorIdx];
+
+            if (chainLength == 0) {
+                LOG_WARN("Removing monitor with no probe nodes (probeHandle={:#x} targetHandle={:#x})", probeHandle,
+                         targetHandle);
+                monitorsToRemove.push_back(monitorIdx);
+                continue;
+            }
+
+            const bool probeValid = m_skeleton.IsActorValid(probeHandle);
+            const bool targetValid = m_skeleton.IsActorValid(targetHandle);
+
+            if (!probeValid || !targetValid) {
+                LOG_INFO("Removing monitor (missing actor) probeHandle={:#x} targetHandle={:#x}", probeHandle,
+                         targetHandle);
+                monitorsToRemove.push_back(monitorIdx);
+                continue;
+            }
+
+            // monitors are indefinite; expiration check removed
+
+            // Bones come from the shared per-actor index; no name searches once an actor is resolved
+            auto*& probeEntry = m_store.probeNodes[monitorIdx];
+            auto*& targetEntry = m_store.targetNodes[monitorIdx];
+            if (!probeEntry || !targetEntry) {
+                probeEntry = &m_nodeIndex.ForActor(probeHandle);
+                targetEntry = &m_nodeIndex.ForActor(targetHandle);
+            }
+
+            // Learned loop: the penetration for this phase comes from the table, so no bone is looked up
+            // or read; every few ticks the monitor is measured live instead to catch drift
+            if (const auto* loop = m_store.loopLearners[monitorIdx].get();
+                loop && loop->IsPlaying() && !loop->IsVerifyDue(tick)) {
+                m_playback.push_back({static_cast<std::uint32_t>(monitorIdx),
+                                      loop->Sample(tick) - m_store.appliedCorrections[monitorIdx]});
+                continue;
+            }
+
+            auto targetNode = m_nodeIndex.Resolve(*targetEntry, m_store.targetNames[monitorIdx]);
+            // A capsule target needs both of its bones
+            const auto& volume = m_store.volumes[monitorIdx];
+            const NodeRef targetEndNode =
+                volume.capsule ? m_nodeIndex.Resolve(*targetEntry, volume.targetEnd) : nullptr;
+            const bool targetReady = targetNode && (!volume.capsule || targetEndNode);
+
+            // Another monitor of the same probe chain was gathered this tick: reuse its reads
+            const auto group = m_groups.groupOf[monitorIdx];
+            const bool probeRead = m_groups.readTicks[group] == tick;
+
+            NodeRef baseNode = nullptr;
+            NodeRef tipNode = nullptr;
+            MonitorStore::BoneMask presentMask = 0;
+            // Positions a volume monitor read for its early reject, reused below
+            bool positionsRead = false;
+            Vector3 baseWorld;
+            Vector3 tipWorld;
+            Vector3 targetPos;
+            if (!probeRead) {
+                auto& probeNodes = *probeEntry;
+
+                // Get base (first) and tip (last) bones for direction/distance calculation
+                baseNode = m_nodeIndex.Resolve(probeNodes, m_store.ChainName(monitorIdx, 0));
+                tipNode = m_nodeIndex.Resolve(probeNodes, m_store.ChainName(monitorIdx, chainLength - 1));
+
+                // Volumes clearly apart: settled before the middle bones are even looked up
+                if (volume.enabled && targetReady && baseNode && tipNode) {
+                    baseWorld = m_skeleton.GetWorldTranslate(baseNode);
+                    tipWorld = m_skeleton.GetWorldTranslate(tipNode);
+                    targetPos = m_skeleton.GetWorldTranslate(targetNode);
+                    positionsRead = true;
+                    if (RejectApartVolumes(monitorIdx, baseWorld, tipWorld, targetPos, targetEndNode, pass)) {
+                        continue;
+                    }
+                }
+
+                // Get middle bones that will actually be moved
+                for (std::size_t idx = 1; idx + 1 < chainLength; ++idx) {
+                    if (m_nodeIndex.Resolve(probeNodes, m_store.ChainName(monitorIdx, idx))) {
+                        presentMask |= MonitorStore::BoneBit(idx);
+                    }
+                }
+            }
+
+            auto& waitingForBones = m_store.waitingForBones[monitorIdx];
+            const bool probeReady = probeRead || (baseNode && tipNode && presentMask != 0);
+            if (!targetReady || !probeReady) {
+                if (!waitingForBones) {
+                    waitingForBones = 1;
+                    LOG_INFO(
+                        "Waiting for bones (probeHandle={:#x} targetHandle={:#x} target={} base={} tip={} "
+                        "middle={})",
+                        probeHandle, targetHandle, targetReady ? "ok" : "missing",
+                        probeRead || baseNode ? "ok" : "missing", probeRead || tipNode ? "ok" : "missing",
+                        std::popcount(presentMask));
+                }
+                continue;
+            }
+
+            if (waitingForBones) {
+                waitingForBones = 0;
+                LOG_INFO("Bones recovered (probeHandle={:#x} targetHandle={:#x})", probeHandle, targetHandle);
+            }
+
+            // Gather CURRENT world positions; penetration should reflect the live pose
+            if (!positionsRead) {
+                targetPos = m_skeleton.GetWorldTranslate(targetNode);
+            }
+            if (probeRead) {
+                const auto lane = m_groups.readLanes[group];
+                const Vector3 base{m_gather.baseX[lane], m_gather.baseY[lane], m_gather.baseZ[lane]};
+                const Vector3 tip{m_gather.tipX[lane], m_gather.tipY[lane], m_gather.tipZ[lane]};
+                if (volume.enabled && RejectApartVolumes(monitorIdx, base, tip, targetPos, targetEndNode, pass)) {
+                    continue;
+                }
+                m_gather.Push(static_cast<std::uint32_t>(monitorIdx), m_gather.presentMasks[lane], base, tip,
+                              targetPos);
+                continue;
+            }
+            if (!positionsRead) {
+                baseWorld = m_skeleton.GetWorldTranslate(baseNode);
+                tipWorld = m_skeleton.GetWorldTranslate(tipNode);
+            }
+            m_groups.readTicks[group] = tick;
+            m_groups.readLanes[group] = static_cast<std::uint32_t>(m_gather.monitorIndices.size());
+            m_gather.Push(static_cast<std::uint32_t>(monitorIdx), presentMask, baseWorld, tipWorld, targetPos);
+        }
+
+        // Probe direction, length and tip penetration for every gathered monitor in one batched pass
+        ComputePenetration(m_gather.Batch());
+
+        // Every monitor decides on its own; the bones of each group are written once afterwards, so a
+        // correction from one member is never seen (or undone) by another in the same pass
+        for (std::size_t lane = 0; lane < m_gather.monitorIndices.size(); ++lane) {
+            const std::size_t monitorIdx = m_gather.monitorIndices[lane];
+
+            if (m_gather.probeLength[lane] < 0.001f) {
+                // Probe bones are too close together, can't determine direction
+                LOG_DEBUG("Probe bones too close together (probeHandle={:#x})", m_store.probeHandles[monitorIdx]);
+                continue;
+            }
+
+            const float tipPenetration = m_store.volumes[monitorIdx].enabled
+                                             ? MeasureVolumeOverlap(monitorIdx, lane, pass)
+                                             : m_gather.tipPenetration[lane];
+            m_store.presentMasks[monitorIdx] = m_gather.presentMasks[lane];
+
+            if (auto* loop = m_store.loopLearners[monitorIdx].get()) {
+                // The animation's own pose: the measurement alone jumps whenever the correction switches
+                const float posePenetration = tipPenetration + m_store.appliedCorrections[monitorIdx];
+                if (!loop->IsPlaying()) {
+                    if (loop->Record(tick, posePenetration)) {
+                        LOG_DEBUG("Learned animation loop of {:.2f} ticks (probeHandle={:#x})", loop->GetPeriod(),
+                                  m_store.probeHandles[monitorIdx]);
+                    }
+                } else if (!loop->Verify(tick, posePenetration)) {
+                    LOG_DEBUG("Pose drifted from the learned loop, relearning (probeHandle={:#x})",
+                              m_store.probeHandles[monitorIdx]);
+                }
+            }
+
+            const auto evaluation = EvaluateMonitor(monitorIdx, tipPenetration, pass);
+            if (pass.recorder) {
+                m_pendingSamples.push_back(
+                    {static_cast<std::uint32_t>(monitorIdx), static_cast<std::uint32_t>(lane), tipPenetration, evaluation});
+            }
+        }
+
+        for (const auto& playback : m_playback) {
+            const auto evaluation = EvaluateMonitor(playback.monitorIdx, playback.tipPenetration, pass);
+            if (pass.recorder) {
+                m_pendingSamples.push_back(
+                    {playback.monitorIdx, PendingSample::kPlayback, playback.tipPenetration, evaluation});
+            }
+        }
+        m_evaluationStats.playedBack += m_playback.size();
+
+        for (const auto monitorIdx : m_groups.queued) {
+            const auto* loop = m_store.loopLearners[monitorIdx].get();
+            ApplyGroup(monitorIdx,
+                       m_groups.readTicks[m_groups.groupOf[monitorIdx]] == tick && !(loop && loop->IsPlaying()));
+        }
+        if (pass.recorder) {
+            RecordPendingSamples(pass);
+        }
+
+        // Remove monitors in reverse order to maintain indices
+        for (auto it = monitorsToRemove.rbegin(); it != monitorsToRemove.rend(); ++it) {
+            if (*it < m_store.Size()) {
+                SaveCalibration(*it);
+                m_store.Remove(*it);
+                m_registryChanged = true;
+            }
+        }
+        if (!monitorsToRemove.empty()) {
+            PruneNodeIndex();
+        }
+
+        // Check if we still have active monitors
+        if (m_store.Empty()) {
+            LOG_INFO("No more active monitors, stopping tick.");
+            return false;
+        }
+
+        return true;
+    }
+
+    MonitorEngine::Evaluation MonitorEngine::EvaluateMonitor(std::size_t monitorIdx, float tipPenetration,
+                                                             const PassContext& pass) {
+        const auto probeHandle = m_store.probeHandles[monitorIdx];
+        const float distanceThreshold = m_store.distanceThresholds[monitorIdx];
+        const float restoreThreshold = m_store.restoreThresholds[monitorIdx];
+        auto& engaged = m_store.engaged[monitorIdx];
+
+        // tipPenetration: positive = probe has gone beyond target in forward direction,
+        // negative = probe hasn't reached target yet
+
+        // Predictive correction: while the tip is rising, engage on where it will be lookAhead ticks from
+        // now so bones move before the threshold is crossed rather than a tick after. The prediction only
+        // decides when to engage; the learned pullback comes from the measured tip, since it is kept for
+        // the whole loop and saved with the calibration. Restoring still waits for the actual tip, which
+        // keeps the correction on until the pose has really receded.
+        auto& history = m_store.penetrationHistory[monitorIdx];
+        history.Push(pass.tick, tipPenetration);
+        const float velocity = history.Slope();
+        const float predictedPenetration = tipPenetration + std::max(velocity, 0.0f) * pass.lookAheadTicks;
+
+        LOG_TRACE(
+            "Penetration check: probeHandle={:#x} tipPenetration={:.3f} predicted={:.3f} shrinkThreshold={:.3f} "
+            "restoreThreshold={:.3f}",
+            probeHandle, tipPenetration, predictedPenetration, distanceThreshold, restoreThreshold);
+
+        // The measurement already includes the pullback the bones apply now; adding it back gives what
+        // the animation's own pose needs, so the bones' own writes never raise the requirement
+        const float applied = m_store.appliedCorrections[monitorIdx];
+        Evaluation evaluation{predictedPenetration, 0.0f, SampleAction::Hold};
+        if (predictedPenetration > distanceThreshold) {
+            // Track max for telemetry, but drive offset from cached maximum beyond threshold
+            auto& maxPenetration = m_store.metadata[monitorIdx].maxPenetration;
+            if (tipPenetration > maxPenetration) {
+                maxPenetration = tipPenetration;
+                LOG_DEBUG("New max penetration: {:.3f} (probeHandle={:#x})", maxPenetration, probeHandle);
+            }
+
+            auto& maxBeyond = m_store.maxPenetrationBeyondThreshold[monitorIdx];
+            const float requiredBeyond = tipPenetration + applied - distanceThreshold;
+            if (requiredBeyond > maxBeyond) {
+                maxBeyond = requiredBeyond;
+                LOG_DEBUG("New max penetration beyond threshold: {:.3f} (probeHandle={:#x})", maxBeyond,
+                          probeHandle);
+            }
+            engaged = 1;
+            evaluation.action = SampleAction::Shrink;
+        } else if (tipPenetration + applied <= restoreThreshold) {
+            // The uncorrected pose is at or below the restore threshold: this monitor no longer needs the
+            // bones moved. Judging the pose rather than the corrected tip keeps a restore from re-triggering
+            // the shrink. Keep maxPenetration - it represents the learned maximum for this looped animation.
+            engaged = 0;
+            evaluation.action = SampleAction::Restore;
+        }
+        // else: tipPenetration is between restoreThreshold and distanceThreshold - maintain current state
+
+        // Bones are settled once per group after every member has decided
+        const auto group = m_groups.groupOf[monitorIdx];
+        if (m_groups.queuedTicks[group] != pass.tick) {
+            m_groups.queuedTicks[group] = pass.tick;
+            m_groups.queued.push_back(static_cast<std::uint32_t>(monitorIdx));
+        }
+
+        // A loop being recorded needs a sample on every tick
+        const auto* loop = m_store.loopLearners[monitorIdx].get();
+        const bool recording = loop && !loop->IsPlaying();
+        m_store.nextEvalTicks[monitorIdx] =
+            pass.tick + (recording ? 1
+                                   : NextEvalInterval(tipPenetration, history, pass.lookAheadTicks,
+                                                      distanceThreshold, restoreThreshold,
+                                                      m_store.movedMasks[monitorIdx] != 0, pass.maxEvalInterval));
+        return evaluation;
+    }
+
+    void MonitorEngine::ApplyGroup(std::size_t monitorIdx, bool liveRead) {
+        const auto group = m_groups.groupOf[monitorIdx];
+        const auto members = m_groups.Members(group);
+
+        // Merged demand: the largest pullback any engaged member needs
+        bool anyEngaged = false;
+        float pullback = 0.0f;
+        for (const auto member : members) {
+            if (m_store.engaged[member]) {
+                anyEngaged = true;
+                pullback = std::max(pullback, m_store.maxPenetrationBeyondThreshold[member]);
+            }
+        }
+
+        const auto probeHandle = m_store.probeHandles[monitorIdx];
+        const std::size_t chainLength = m_store.chainLengths[monitorIdx];
+        const auto& metadata = m_store.metadata[monitorIdx];
+        const MonitorStore::BoneMask presentMask = m_store.presentMasks[monitorIdx];
+        auto& movedMask = m_store.movedMasks[monitorIdx];
+        auto& probeNodes = *m_store.probeNodes[monitorIdx];
+
+        // World data is refreshed once per chain after all of its bone writes
+        ChainUpdate update(m_skeleton);
+
+        if (!anyEngaged) {
+            // Every member is at or below its restore threshold - restore all moved middle bones
+            const MonitorStore::BoneMask toRestore = movedMask & presentMask;
+            if (toRestore == 0 && m_store.appliedCorrections[monitorIdx] == 0.0f) {
+                return;
+            }
+            for (std::size_t idx = 1; toRestore && idx + 1 < chainLength; ++idx) {
+                if (MonitorStore::IsMoved(toRestore, idx)) {
+                    RestoreBonePosition(probeNodes, m_store.ChainName(monitorIdx, idx), update);
+                    movedMask &= ~MonitorStore::BoneBit(idx);
+                    LOG_TRACE("Restored bone (probeHandle={:#x} node={})", probeHandle,
+                              GetNodeLabel(metadata.probeNodes[idx]));
+                }
+            }
+            m_store.appliedCorrections[monitorIdx] = 0.0f;
+            m_store.requestedPullbacks[monitorIdx] = 0.0f;
+            MirrorGroupState(group, monitorIdx);
+            return;
+        }
+
+        // Only update bones when the merged demand changed OR some have not been moved yet; every present
+        // bone is written then, since the solution spreads over all of them
+        if (pullback == m_store.requestedPullbacks[monitorIdx] && (presentMask & ~movedMask) == 0) {
+            return;
+        }
+
+        // Shrinking starts from the animated pose: measure the chain before any bone of it moves. A group
+        // running on a learned loop keeps its earlier measurement so playback stays read-free.
+        if ((movedMask & presentMask) == 0 && (liveRead || (presentMask & ~m_store.restMasks[monitorIdx]) != 0)) {
+            MeasureChainRest(monitorIdx, presentMask);
+        }
+
+        std::array<float, MonitorStore::kMaxChainLength> offsets{};
+        m_store.appliedCorrections[monitorIdx] = SolveOffsets(monitorIdx, presentMask, pullback, offsets);
+        m_store.requestedPullbacks[monitorIdx] = pullback;
+        for (std::size_t idx = 1; idx + 1 < chainLength; ++idx) {
+            if (!MonitorStore::IsMoved(presentMask, idx)) {
+                continue;
+            }
+
+            const bool wasMoved = MonitorStore::IsMoved(movedMask, idx);
+            MoveBoneToTarget(probeNodes, m_store.ChainName(monitorIdx, idx), offsets[idx], update);
+            movedMask |= MonitorStore::BoneBit(idx);
+
+            if (!wasMoved) {
+                LOG_TRACE("Moved bone (probeHandle={:#x} node={} offset={:.2f} pullback={:.2f} members={})",
+                          probeHandle, GetNodeLabel(metadata.probeNodes[idx]), offsets[idx], pullback,
+                          members.size());
+            }
+        }
+        MirrorGroupState(group, monitorIdx);
+    }
+
+    void MonitorEngine::RecordPendingSamples(const PassContext& pass) {
+        for (auto& pending : m_pendingSamples) {
+            const std::size_t monitorIdx = pending.monitorIdx;
+            if (pending.evaluation.action == SampleAction::Shrink) {
+                std::array<float, MonitorStore::kMaxChainLength> offsets{};
+                SolveOffsets(monitorIdx, m_store.presentMasks[monitorIdx], m_store.requestedPullbacks[monitorIdx],
+                             offsets);
+                pending.evaluation.offset = *std::max_element(offsets.begin(), offsets.end());
+            }
+
+            auto sample = MakeSample(pass, monitorIdx, pending.tipPenetration, pending.evaluation);
+            if (pending.lane == PendingSample::kPlayback) {
+                sample.source = SampleSource::Playback;
+            } else {
+                const auto lane = pending.lane;
+                sample.base = {m_gather.baseX[lane], m_gather.baseY[lane], m_gather.baseZ[lane]};
+                sample.tip = {m_gather.tipX[lane], m_gather.tipY[lane], m_gather.tipZ[lane]};
+                sample.target = {m_gather.targetX[lane], m_gather.targetY[lane], m_gather.targetZ[lane]};
+            }
+            pass.recorder->Record(sample);
+        }
+    }
+
+    bool MonitorEngine::RejectApartVolumes(std::size_t monitorIdx, const Vector3& base, const Vector3& tip,
+                                           const Vector3& target, NodeRef targetEndNode, const PassContext& pass) {
+        // Only an idle monitor may skip the test: moved bones must be restored by a later evaluation, a loop
+        // learner needs live samples, and the chain's reach is unknown until its first exact test
+        const float span = m_store.chainSpans[monitorIdx];
+        if (span <= 0.0f || m_store.movedMasks[monitorIdx] != 0 || m_store.engaged[monitorIdx] ||
+            m_store.loopLearners[monitorIdx]) {
+            return false;
+        }
+
+        const auto& volume = m_store.volumes[monitorIdx];
+        const Vector3 targetEnd = targetEndNode ? m_skeleton.GetWorldTranslate(targetEndNode) : target;
+        const auto chainBound = BoundPath(base, tip, span, volume.probeRadius);
+        const auto targetBound = BoundPath(target, targetEnd, (targetEnd - target).Length(), volume.targetRadius);
+
+        // The overlap cannot exceed minus the gap between the bounds. Apart means the bounds do not touch
+        // and even the look-ahead at the recent peak speed stays clear of the shrink threshold.
+        const float overlapBound = -SphereGap(chainBound, targetBound);
+        const auto& history = m_store.penetrationHistory[monitorIdx];
+        const float threshold = m_store.distanceThresholds[monitorIdx];
+        if (overlapBound >= 0.0f ||
+            overlapBound + history.PeakSpeed() * pass.lookAheadTicks > threshold - kEvalNearMargin) {
+            return false;
+        }
+
+        ++m_evaluationStats.rejected;
+        // Scheduled as if the overlap sat at its bound, which the real one can only fall short of
+        m_store.nextEvalTicks[monitorIdx] =
+            pass.tick + NextEvalInterval(overlapBound, history, pass.lookAheadTicks, threshold,
+                                         m_store.restoreThresholds[monitorIdx], false, pass.maxEvalInterval);
+        return true;
+    }
+
+    float MonitorEngine::MeasureVolumeOverlap(std::size_t monitorIdx, std::size_t lane, const PassContext& pass) {
+        // Every member of a group tests the same chain: its bones are read once per tick and shared
+        const auto group = m_groups.groupOf[monitorIdx];
+        if (m_groups.pointTicks[group] != pass.tick) {
+            auto& probeNodes = *m_store.probeNodes[monitorIdx];
+            const std::size_t chainLength = m_store.chainLengths[monitorIdx];
+            const MonitorStore::BoneMask presentMask = m_gather.presentMasks[lane];
+            const auto offset = m_chainPoints.size();
+            m_chainPoints.push_back({m_gather.baseX[lane], m_gather.baseY[lane], m_gather.baseZ[lane]});
+            for (std::size_t idx = 1; idx + 1 < chainLength; ++idx) {
+                if (!MonitorStore::IsMoved(presentMask, idx)) {
+                    continue;
+                }
+                if (const auto node = m_nodeIndex.Resolve(probeNodes, m_store.ChainName(monitorIdx, idx))) {
+                    m_chainPoints.push_back(m_skeleton.GetWorldTranslate(node));
+                }
+            }
+            m_chainPoints.push_back({m_gather.tipX[lane], m_gather.tipY[lane], m_gather.tipZ[lane]});
+            m_groups.pointTicks[group] = pass.tick;
+            m_groups.pointOffsets[group] = static_cast<std::uint32_t>(offset);
+            m_groups.pointCounts[group] = static_cast<std::uint8_t>(m_chainPoints.size() - offset);
+        }
+        const std::span<const Vector3> chain{m_chainPoints.data() + m_groups.pointOffsets[group],
+                                             m_groups.pointCounts[group]};
+
+        // The reject bounds the chain by its length, so only an unmoved chain may set it
+        if (m_store.movedMasks[monitorIdx] == 0) {
+            float span = 0.0f;
+            for (std::size_t i = 1; i < chain.size(); ++i) {
+                span += (chain[i] - chain[i - 1]).Length();
+            }
+            m_store.chainSpans[monitorIdx] = std::max(m_store.chainSpans[monitorIdx], span);
+        }
+
+        const auto& volume = m_store.volumes[monitorIdx];
+        const Vector3 target{m_gather.targetX[lane], m_gather.targetY[lane], m_gather.targetZ[lane]};
+        Vector3 targetEnd = target;
+        if (volume.capsule) {
+            if (const auto node = m_nodeIndex.Resolve(*m_store.targetNodes[monitorIdx], volume.targetEnd)) {
+                targetEnd = m_skeleton.GetWorldTranslate(node);
+            }
+        }
+        return CapsuleOverlap(chain, volume.probeRadius, target, targetEnd, volume.targetRadius);
+    }
+
+    void MonitorEngine::RebuildProbeGroups() {
+        const std::size_t count = m_store.Size();
+        auto& members = m_groups.members;
+        members.resize(count);
+        std::iota(members.begin(), members.end(), 0u);
+        // Members of a group end up adjacent; ties keep slot order so the first slot leads
+        std::stable_sort(members.begin(), members.end(), [this](std::uint32_t a, std::uint32_t b) {
+            if (m_store.probeHandles[a] != m_store.probeHandles[b]) {
+                return m_store.probeHandles[a] < m_store.probeHandles[b];
+            }
+            const auto chainA = m_store.chainNames.begin() + m_store.chainOffsets[a];
+            const auto chainB = m_store.chainNames.begin() + m_store.chainOffsets[b];
+            return std::lexicographical_compare(chainA, chainA + m_store.chainLengths[a], chainB,
+                                                chainB + m_store.chainLengths[b]);
+        });
+
+        m_groups.groupOf.resize(count);
+        m_groups.firstMember.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i == 0 || !m_store.SharesProbeChain(members[i - 1], members[i])) {
+                m_groups.firstMember.push_back(static_cast<std::uint32_t>(i));
+            }
+            m_groups.groupOf[members[i]] = static_cast<std::uint32_t>(m_groups.firstMember.size() - 1);
+        }
+        const std::size_t groups = m_groups.firstMember.size();
+        m_groups.firstMember.push_back(static_cast<std::uint32_t>(count));
+
+        m_groups.readTicks.assign(groups, 0);
+        m_groups.readLanes.assign(groups, 0);
+        m_groups.queuedTicks.assign(groups, 0);
+        m_groups.pointTicks.assign(groups, 0);
+        m_groups.pointOffsets.assign(groups, 0);
+        m_groups.pointCounts.assign(groups, 0);
+        m_groups.queued.clear();
+        m_groups.queued.reserve(groups);
+
+        // A monitor joining a chain that is already moved takes over the chain's state; the member that
+        // moved it furthest holds it
+        for (std::uint32_t group = 0; group < groups; ++group) {
+            const auto groupMembers = m_groups.Members(group);
+            if (groupMembers.size() < 2) {
+                continue;
+            }
+            const auto source = *std::max_element(groupMembers.begin(), groupMembers.end(),
+                                                  [this](std::uint32_t a, std::uint32_t b) {
+                                                      return m_store.appliedCorrections[a] <
+                                                             m_store.appliedCorrections[b];
+                                                  });
+            MirrorGroupState(group, source);
+        }
+        if (groups < count) {
+            LOG_DEBUG("{} monitor(s) share {} probe chain(s)", count, groups);
+        }
+    }
+
+    void MonitorEngine::MirrorGroupState(std::uint32_t group, std::size_t source) {
+        const auto members = m_groups.Members(group);
+        if (members.size() < 2) {
+            return;
+        }
+        const std::size_t chainLength = m_store.chainLengths[source];
+        for (const auto member : members) {
+            if (member == source) {
+                continue;
+            }
+            m_store.movedMasks[member] = m_store.movedMasks[source];
+            m_store.appliedCorrections[member] = m_store.appliedCorrections[source];
+            m_store.requestedPullbacks[member] = m_store.requestedPullbacks[source];
+            m_store.restMasks[member] = m_store.restMasks[source];
+            for (std::size_t idx = 1; idx + 1 < chainLength; ++idx) {
+                m_store.Rest(member, idx) = m_store.Rest(source, idx);
+            }
+        }
+    }
+
+    void MonitorEngine::MeasureChainRest(std::size_t monitorIdx, MonitorStore::BoneMask presentMask) {
+        auto& probeNodes = *m_store.probeNodes[monitorIdx];
+        const std::size_t chainLength = m_store.chainLengths[monitorIdx];
+        const auto baseNode = m_nodeIndex.Resolve(probeNodes, m_store.ChainName(monitorIdx, 0));
+        const auto tipNode = m_nodeIndex.Resolve(probeNodes, m_store.ChainName(monitorIdx, chainLength - 1));
+        if (!baseNode || !tipNode) {
+            return;
+        }
+
+        const auto base = m_skeleton.GetWorldTranslate(baseNode);
+        const auto probe = m_skeleton.GetWorldTranslate(tipNode) - base;
+        const float probeLength = probe.Length();
+        if (probeLength < 0.001f) {
+            return;
+        }
+        const auto direction = probe / probeLength;
+
+        MonitorStore::BoneMask measured = 0;
+        auto previous = base;
+        for (std::size_t idx = 1; idx + 1 < chainLength; ++idx) {
+            if (!MonitorStore::IsMoved(presentMask, idx)) {
+                continue;
+            }
+            const auto node = m_nodeIndex.Resolve(probeNodes, m_store.ChainName(monitorIdx, idx));
+            if (!node) {
+                continue;
+            }
+            // A bone's translate moves it along the segment from its parent; only the part along the
+            // probe shortens the reach, and a segment pointing backwards cannot be folded forward
+            const auto position = m_skeleton.GetWorldTranslate(node);
+            const auto segment = position - previous;
+            const float segmentLength = segment.Length();
+            const float length = std::max(segment.Dot(direction), 0.0f);
+            m_store.Rest(monitorIdx, idx) = {length, segmentLength > 1e-4f ? length / segmentLength : 0.0f};
+            measured |= MonitorStore::BoneBit(idx);
+            previous = position;
+        }
+        m_store.restMasks[monitorIdx] = measured;
+    }
+
+    float MonitorEngine::SolveOffsets(std::size_t monitorIdx, MonitorStore::BoneMask presentMask, float pullback,
+                                      std::array<float, MonitorStore::kMaxChainLength>& offsets) {
+        const std::size_t chainLength = m_store.chainLengths[monitorIdx];
+        if (pullback <= 0.0f) {
+            return 0.0f;
+        }
+
+        // Every bone moves the same fraction k of its rest length along the probe, which pulls the tip
+        // back by k * sum(length * gain); solving for k meets the pullback in one step. k <= 1 keeps
+        // each bone in front of its parent; past that the chain cannot shorten any further. Offsets are in
+        // world units like the rest lengths; MoveBoneToTarget converts them into each parent's space.
+        if ((presentMask & ~m_store.restMasks[monitorIdx]) == 0) {
+            float reach = 0.0f;
+            for (std::size_t idx = 1; idx + 1 < chainLength; ++idx) {
+                if (MonitorStore::IsMoved(presentMask, idx)) {
+                    const auto& rest = m_store.Rest(monitorIdx, idx);
+                    reach += rest.length * rest.gain;
+                }
+            }
+            if (reach > 1e-4f) {
+                const float fraction = std::min(pullback / reach, 1.0f);
+                for (std::size_t idx = 1; idx + 1 < chainLength; ++idx) {
+                    if (MonitorStore::IsMoved(presentMask, idx)) {
+                        offsets[idx] = fraction * m_store.Rest(monitorIdx, idx).length;
+                    }
+                }
+                return fraction * reach;
+            }
+        }
+
+        // Rest pose unknown (a bone appeared while the chain was moved) or degenerate: split evenly and
+        // assume every bone lies along the probe
+        const auto middleCount = std::popcount(presentMask);
+        const float offset = std::min(pullback / static_cast<float>(middleCount), kMaxBoneOffset);
+        for (std::size_t idx = 1; idx + 1 < chainLength; ++idx) {
+            if (MonitorStore::IsMoved(presentMask, idx)) {
+                offsets[idx] = offset;
+            }
+        }
+        return offset * static_cast<float>(middleCount);
+    }
+
+    TickSample MonitorEngine::MakeSample(const PassContext& pass, std::size_t monitorIdx, float tipPenetration,
+                                         const Evaluation& evaluation) const {
+        TickSample sample;
+        sample.tick = pass.tick;
+        sample.timeUs = pass.timeUs;
+        sample.probeHandle = m_store.probeHandles[monitorIdx];
+        sample.targetHandle = m_store.targetHandles[monitorIdx];
+        sample.monitor = static_cast<std::uint32_t>(monitorIdx);
+        sample.movedMask = m_store.movedMasks[monitorIdx];
+        sample.chainLength = m_store.chainLengths[monitorIdx];
+        sample.tipPenetration = tipPenetration;
+        sample.predictedPenetration = evaluation.predictedPenetration;
+        sample.distanceThreshold = m_store.distanceThresholds[monitorIdx];
+        sample.restoreThreshold = m_store.restoreThresholds[monitorIdx];
+        sample.offset = evaluation.offset;
+        sample.action = evaluation.action;
+        return sample;
+    }
+
+}  // namespace KYL
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "CalibrationCache.h"
+#include "MonitorStore.h"
+#include "MpscQueue.h"
+#include "NodeIndex.h"
+#include "PenetrationKernel.h"
+#include "SampleRecorder.h"
+#include "Skeleton.h"
+#include "TickMetrics.h"
+#include "VolumeTest.h"
+
+namespace KYL {
+
+    // Tolerance for position comparisons. The solved pullback spreads over every middle bone, so a skipped
+    // write leaves the tip short of the threshold by up to this much per bone: keep it below visible motion.
+    constexpr float kPositionTolerance = 0.001f;
+    // Per-bone offset cap for chains whose rest pose is unknown
+    constexpr float kMaxBoneOffset = 1.3f;
+    // Monitors away from both thresholds are evaluated at most every this many ticks
+    constexpr std::uint32_t kDefaultMaxEvalInterval = 5;
+    // Tip closer than this to a threshold it can cross is evaluated on every tick
+    constexpr float kEvalNearMargin = 0.5f;
+    // Longest prediction look-ahead accepted, in ticks
+    constexpr float kMaxLookAheadTicks = 4.0f;
+
+    // Everything needed to create or update a monitor
+    struct MonitorSpec {
+        ActorHandle probeHandle{0};
+        std::vector<std::string> probeNodes;
+        ActorHandle targetHandle{0};
+        std::string targetNode;
+        float distanceThreshold{0.0f};
+        float restoreThreshold{0.0f};
+        // Capsule test instead of the tip projection when enabled; the thresholds are overlap depths then
+        VolumeSpec volume;
+        // Scene or action the monitor belongs to. With a calibration cache attached, the maxima learned
+        // for this scene, target node and probe chain survive the monitor; empty opts out.
+        std::string calibrationKey;
+    };
+
+    // Heap allocations made inside steady-state ticks, i.e. ticks where the monitor set did not change
+    // since the previous tick. Stays zero unless built with KYL_TRACK_ALLOCATIONS.
+    struct TickAllocationStats {
+        std::uint64_t steadyTicks{0};
+        std::uint64_t ticksWithAllocations{0};
+        std::uint64_t allocations{0};
+    };
+
+    // How many monitors the adaptive schedule evaluated or deferred; playedBack counts the evaluations
+    // answered from a learned loop table instead of the skeleton, rejected those of volume monitors that
+    // the bounding-sphere test settled without the exact test
+    struct EvaluationStats {
+        std::uint64_t ticks{0};
+        std::uint64_t evaluated{0};
+        std::uint64_t deferred{0};
+        std::uint64_t playedBack{0};
+        std::uint64_t rejected{0};
+    };
+
+    // Identifies a queued add/remove in the logs; 0 means the request was rejected before queueing
+    using CommandTicket = std::uint32_t;
+
+    // Penetration monitoring core: owns the monitor registry and runs the per-tick
+    // hysteresis and bone-offset logic against an ISkeleton backend.
+    //
+    // Registry changes are queued from any thread and applied by Tick on its own thread, so the
+    // tick owns the registry without a lock and callers never wait for a running pass.
+    class MonitorEngine {
+    public:
+        explicit MonitorEngine(ISkeleton& skeleton) : m_skeleton(skeleton), m_nodeIndex(skeleton) {}
+
+        MonitorEngine(const MonitorEngine&) = delete;
+        MonitorEngine& operator=(const MonitorEngine&) = delete;
+
+        // Queue creating a monitor or updating the one matching probe/target/target node
+        CommandTicket AddMonitor(MonitorSpec spec);
+
+        // Queue several monitors (e.g. every action of a scene) as one command under one ticket, applied
+        // in a single registry update. Invalid specs are logged and skipped; 0 if none was valid.
+        CommandTicket AddMonitors(std::vector<MonitorSpec> specs);
+
+        // Queue making specs the monitor set of their actors and of actors: monitors touching those actors
+        // that specs does not list are removed and restored, listed ones that already run with the same
+        // probe chain keep their nodes, moved bones and learned maxima, and the rest are created
+        CommandTicket ApplyMonitorSet(std::vector<ActorHandle> actors, std::vector<MonitorSpec> specs);
+
+        // Queue removing monitors touching any of the handles (all monitors if empty); moved bones are
+        // restored when the removal is applied
+        CommandTicket RemoveMonitors(std::vector<ActorHandle> handles);
+
+        // Seed new monitors from, and save their learned maxima to, this cache (nullptr detaches). Set
+        // before monitors are added; the cache must outlive the engine or be detached first.
+        void SetCalibrationCache(CalibrationCache* cache) { m_calibration.store(cache, std::memory_order_release); }
+
+        // Copy every evaluation into this recorder while it records (nullptr detaches); same lifetime rule
+        // as the calibration cache
+        void SetSampleRecorder(SampleRecorder* recorder) { m_recorder.store(recorder, std::memory_order_release); }
+
+        // Queue dropping the actor's cached nodes; call when its 3D is loaded or unloaded
+        void InvalidateActor(ActorHandle actor);
+
+        // Drop queued commands, restore all moved bones and clear every monitor; returns how many were
+        // cleared. Waits for a tick that is currently running on another thread.
+        std::size_t Clear();
+
+        // Apply queued commands, then evaluate every monitor once; returns false when no monitors remain
+        bool Tick();
+
+        // Commands queued but not yet applied. Call from the ticking thread.
+        bool HasPendingCommands() const;
+
+        // Monitor count as of the last applied command or tick
+        std::size_t Size() const;
+
+        // Upper bound, in ticks, on how long a monitor far from its thresholds waits between evaluations;
+        // 1 evaluates every monitor on every tick. The tick interval is the maximum evaluation rate.
+        void SetMaxEvalInterval(std::uint32_t ticks) { m_maxEvalInterval.store(ticks, std::memory_order_relaxed); }
+        std::uint32_t GetMaxEvalInterval() const { return m_maxEvalInterval.load(std::memory_order_relaxed); }
+
+        // How far ahead, in ticks, the shrink decision extrapolates a rising tip; 0 reacts to the current
+        // pose only. Clamped to [0, kMaxLookAheadTicks].
+        void SetLookAheadTicks(float ticks);
+        float GetLookAheadTicks() const { return m_lookAheadTicks.load(std::memory_order_relaxed); }
+
+        // Loop learning: each monitor records its tip penetration for a few animation cycles, then reads
+        // it from the learned loop instead of the skeleton, with periodic live checks for drift
+        void SetLoopLearning(bool enabled) { m_loopLearning.store(enabled, std::memory_order_relaxed); }
+        bool IsLoopLearningEnabled() const { return m_loopLearning.load(std::memory_order_relaxed); }
+
+        // Call from the ticking thread
+        TickAllocationStats GetAllocationStats() const;
+        void ResetAllocationStats();
+        EvaluationStats GetEvaluationStats() const { return m_evaluationStats; }
+        void ResetEvaluationStats() { m_evaluationStats = {}; }
+
+        // Per-tick cost histograms, recorded on every tick that runs a pass. Readable from any thread;
+        // the adapter adds the queue delay of the ticks it posts.
+        TickMetrics& GetMetrics() { return m_metrics; }
+        const TickMetrics& GetMetrics() const { return m_metrics; }
+
+    private:
+        // Positions of the monitors that are ready this tick, gathered for the batched penetration kernel.
+        // Kept across ticks so the arrays only grow when the monitor count does.
+        struct GatherBuffers {
+            std::vector<std::uint32_t> monitorIndices;
+            std::vector<MonitorStore::BoneMask> presentMasks;
+            std::vector<float> baseX, baseY, baseZ;
+            std::vector<float> tipX, tipY, tipZ;
+            std::vector<float> targetX, targetY, targetZ;
+            std::vector<float> directionX, directionY, directionZ;
+            std::vector<float> probeLength;
+            std::vector<float> tipPenetration;
+
+            void Clear();
+            // Room for every monitor, so how many are gathered on a later tick never triggers a reallocation
+            void Reserve(std::size_t count);
+            void Push(std::uint32_t monitorIdx, MonitorStore::BoneMask presentMask, const Vector3& base,
+                      const Vector3& tip, const Vector3& target);
+            PenetrationBatch Batch();
+        };
+
+        // Monitors sharing a probe actor and bone chain (one probe in several actions) move the same bones.
+        // Each group's probe is read once per tick and its bones get one merged pullback: the largest any
+        // engaged member needs. Rebuilt whenever the registry changes; per-group arrays are indexed by group.
+        struct ProbeGroups {
+            // Per slot
+            std::vector<std::uint32_t> groupOf;
+            // Slots ordered by group; group g owns members[firstMember[g] .. firstMember[g + 1])
+            std::vector<std::uint32_t> members;
+            std::vector<std::uint32_t> firstMember;
+            // Tick the probe was last read and the gather lane that holds the read
+            std::vector<std::uint64_t> readTicks;
+            std::vector<std::uint32_t> readLanes;
+            // Tick the group was last queued for a bone update, and the queue for this pass (member slots)
+            std::vector<std::uint64_t> queuedTicks;
+            std::vector<std::uint32_t> queued;
+            // Tick the chain's bones were read for the volume test, and where they sit in m_chainPoints
+            std::vector<std::uint64_t> pointTicks;
+            std::vector<std::uint32_t> pointOffsets;
+            std::vector<std::uint8_t> pointCounts;
+
+            std::size_t Count() const { return readTicks.size(); }
+            std::span<const std::uint32_t> Members(std::uint32_t group) const {
+                return {members.data() + firstMember[group], firstMember[group + 1] - firstMember[group]};
+            }
+        };
+
+        // Monitor answered from its learned loop this tick
+        struct PlaybackLane {
+            std::uint32_t monitorIdx;
+            float tipPenetration;
+        };
+
+        // Settings sampled once at the start of a pass
+        struct PassContext {
+            std::uint64_t tick;
+            float lookAheadTicks;
+            std::uint32_t maxEvalInterval;
+            // Set only while a recording runs; timeUs stamps every sample of the pass
+            SampleRecorder* recorder;
+            std::uint64_t timeUs;
+        };
+
+        // What an evaluation decided, for the sample recorder
+        struct Evaluation {
+            float predictedPenetration;
+            float offset;
+            SampleAction action;
+        };
+
+        // Evaluation waiting for the bone updates of the pass before it is recorded
+        struct PendingSample {
+            static constexpr std::uint32_t kPlayback = ~std::uint32_t{0};
+
+            std::uint32_t monitorIdx;
+            // Gather lane with the positions, kPlayback for a monitor answered from its loop
+            std::uint32_t lane;
+            float tipPenetration;
+            Evaluation evaluation;
+        };
+
+        struct AddRequest {
+            MonitorSpec spec;
+            // Cache entry of the monitor and what it held when the command was queued
+            CalibrationCache::Key calibrationKey{0};
+            std::optional<Calibration> calibration;
+        };
+
+        struct Command {
+            enum class Type : std::uint8_t { Add, Remove, Replace, InvalidateActor };
+
+            Type type{Type::Add};
+            CommandTicket ticket{0};
+            // Add: one request from AddMonitor, several from AddMonitors; Replace: the desired set
+            std::vector<AddRequest> adds;
+            // Remove: actors whose monitors stop (all if empty); Replace: actors the set applies to
+            std::vector<ActorHandle> handles;
+        };
+
+        // Only one thread applies commands and touches the registry at a time (the ticking thread,
+        // or Clear during shutdown)
+        class ConsumerScope {
+        public:
+            ConsumerScope(std::atomic<bool>& flag, bool wait);
+            ~ConsumerScope();
+            explicit operator bool() const { return m_owned; }
+
+        private:
+            std::atomic<bool>& m_flag;
+            bool m_owned{false};
+        };
+
+        static bool IsValidSpec(const MonitorSpec& spec);
+        AddRequest MakeAddRequest(MonitorSpec spec);
+        CommandTicket Submit(Command command);
+        void ApplyCommands();
+        void ApplyAdd(const Command& command);
+        // Returns true if an existing monitor was updated rather than a new one created
+        bool ApplyAddRequest(const AddRequest& request, CommandTicket ticket);
+        void ApplyRemove(const Command& command);
+        // Returns how many monitors were removed
+        std::size_t ApplyReplace(const Command& command);
+        void ApplyInvalidate(ActorHandle actor);
+        void SaveCalibration(std::size_t index);
+        void PruneNodeIndex();
+        void SyncLoopLearners();
+        void RebuildProbeGroups();
+        // Copy the bone state (moved bones, pullback, rest pose) of source to the rest of its group
+        void MirrorGroupState(std::uint32_t group, std::size_t source);
+        bool RunPass();
+        // Updates the monitor's own state and decides its action; bones are written by ApplyGroup
+        Evaluation EvaluateMonitor(std::size_t monitorIdx, float tipPenetration, const PassContext& pass);
+        // Write the merged pullback of the group monitorIdx belongs to (or restore it once no member is
+        // engaged); liveRead means the probe was read this tick outside loop playback
+        void ApplyGroup(std::size_t monitorIdx, bool liveRead);
+        void RecordPendingSamples(const PassContext& pass);
+        // Volume monitors: true when the bounding spheres of chain and target are far enough apart that the
+        // exact test could not come near the shrink threshold. The monitor is then rescheduled and nothing
+        // else of it is read or written this tick.
+        bool RejectApartVolumes(std::size_t monitorIdx, const Vector3& base, const Vector3& tip, const Vector3& target,
+                                NodeRef targetEndNode, const PassContext& pass);
+        // Exact volume test of a gathered monitor: how deep the chain capsules reach into the target volume
+        float MeasureVolumeOverlap(std::size_t monitorIdx, std::size_t lane, const PassContext& pass);
+        // Record the rest pose of the present middle bones; the chain must be unmoved
+        void MeasureChainRest(std::size_t monitorIdx, MonitorStore::BoneMask presentMask);
+        // Per-bone offsets (by chain position) that pull the tip back by pullback along the probe.
+        // Returns the pullback they achieve, which falls short only when the chain is fully folded.
+        float SolveOffsets(std::size_t monitorIdx, MonitorStore::BoneMask presentMask, float pullback,
+                           std::array<float, MonitorStore::kMaxChainLength>& offsets);
+        // Sample of an evaluated monitor without positions; the caller fills them in for live reads
+        TickSample MakeSample(const PassContext& pass, std::size_t monitorIdx, float tipPenetration,
+                              const Evaluation& evaluation) const;
+
+        // Bones written for one probe chain; world data is recomputed on Flush (or destruction) from the
+        // topmost dirty bones only, since each subtree update also covers the dirty bones beneath it
+        class ChainUpdate {
+        public:
+            explicit ChainUpdate(ISkeleton& skeleton);
+            ~ChainUpdate();
+
+            ChainUpdate(const ChainUpdate&) = delete;
+            ChainUpdate& operator=(const ChainUpdate&) = delete;
+
+            void MarkDirty(NodeRef node);
+            void Flush();
+
+        private:
+            bool HasDirtyAncestor(NodeRef node);
+
+            ISkeleton& m_skeleton;
+            std::array<NodeRef, MonitorStore::kMaxChainLength> m_dirty{};
+            std::size_t m_count{0};
+        };
+
+        void RestoreBonePosition(NodeIndex::ActorNodes& actor, NodeIndex::NameId name, ChainUpdate& update);
+        void MoveBoneToTarget(NodeIndex::ActorNodes& actor, NodeIndex::NameId name, float penetrationDepth,
+                              ChainUpdate& update);
+        void RestoreMiddleBonesForEntry(std::size_t index);
+        // For a monitor about to be removed: restore its bones unless another monitor still moves them, in
+        // which case that monitor is made due so its group drops the departing monitor's demand
+        void ReleaseBonesForEntry(std::size_t index);
+
+        ISkeleton& m_skeleton;
+        MpscQueue<Command> m_commands;
+        std::atomic<CommandTicket> m_nextTicket{0};
+        std::atomic<bool> m_consuming{false};
+        std::atomic<std::size_t> m_size{0};
+        std::atomic<CalibrationCache*> m_calibration{nullptr};
+        std::atomic<SampleRecorder*> m_recorder{nullptr};
+
+        // Owned by the consumer
+        MonitorStore m_store;
+        NodeIndex m_nodeIndex;
+
+        // Scratch reused across ticks so a warmed-up tick performs no heap allocation
+        GatherBuffers m_gather;
+        ProbeGroups m_groups;
+        std::vector<PlaybackLane> m_playback;
+        std::vector<PendingSample> m_pendingSamples;
+        // Bone positions of the chains the volume test read this tick, per group (see ProbeGroups)
+        std::vector<Vector3> m_chainPoints;
+        std::vector<std::size_t> m_removeScratch;
+
+        // Set whenever monitors are added or removed; the next tick is not steady-state
+        bool m_registryChanged{true};
+        TickAllocationStats m_allocationStats;
+
+        std::atomic<std::uint32_t> m_maxEvalInterval{kDefaultMaxEvalInterval};
+        std::atomic<float> m_lookAheadTicks{0.0f};
+        std::atomic<bool> m_loopLearning{false};
+        // Mode the learners were last allocated for
+        bool m_loopLearningActive{false};
+        std::uint64_t m_tickCount{0};
+        EvaluationStats m_evaluationStats;
+        // Local translates written so far; the per-tick delta feeds the metrics
+        std::uint64_t m_boneWrites{0};
+        TickMetrics m_metrics;
+    };
+
+}  // namespace KYL
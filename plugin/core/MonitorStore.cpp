@@ -0,0 +1,225 @@
+#include "MonitorStore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace KYL {
+
+    void MonitorStore::PenetrationHistory::Push(std::uint64_t tick, float value) {
+        // Drop samples that went stale while the monitor was deferred or waiting for bones
+        std::size_t keep = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (tick - ticks[i] <= kMaxAgeTicks) {
+                values[keep] = values[i];
+                ticks[keep] = ticks[i];
+                ++keep;
+            }
+        }
+        if (keep == kCapacity) {
+            std::copy(values.begin() + 1, values.end(), values.begin());
+            std::copy(ticks.begin() + 1, ticks.end(), ticks.begin());
+            --keep;
+        }
+
+        values[keep] = value;
+        ticks[keep] = tick;
+        count = static_cast<std::uint8_t>(keep + 1);
+    }
+
+    float MonitorStore::PenetrationHistory::Slope() const {
+        if (count < 2) {
+            return 0.0f;
+        }
+
+        // Ticks relative to the newest sample keep the sums small
+        const std::uint64_t newest = LatestTick();
+        float meanT = 0.0f;
+        float meanV = 0.0f;
+        for (std::size_t i = 0; i < count; ++i) {
+            meanT -= static_cast<float>(newest - ticks[i]);
+            meanV += values[i];
+        }
+        meanT /= static_cast<float>(count);
+        meanV /= static_cast<float>(count);
+
+        float covariance = 0.0f;
+        float variance = 0.0f;
+        for (std::size_t i = 0; i < count; ++i) {
+            const float dt = -static_cast<float>(newest - ticks[i]) - meanT;
+            covariance += dt * (values[i] - meanV);
+            variance += dt * dt;
+        }
+        return variance > 0.0f ? covariance / variance : 0.0f;
+    }
+
+    float MonitorStore::PenetrationHistory::PeakSpeed() const {
+        float peak = 0.0f;
+        for (std::size_t i = 1; i < count; ++i) {
+            const auto dt = static_cast<float>(ticks[i] - ticks[i - 1]);
+            peak = std::max(peak, std::abs(values[i] - values[i - 1]) / dt);
+        }
+        return peak;
+    }
+
+    std::optional<std::size_t> MonitorStore::Find(ActorHandle probeHandle, ActorHandle targetHandle,
+                                                  const std::string& targetNode) const {
+        for (std::size_t i = 0; i < Size(); ++i) {
+            if (probeHandles[i] == probeHandle && targetHandles[i] == targetHandle &&
+                metadata[i].targetNode == targetNode) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    bool MonitorStore::SharesProbeChain(std::size_t a, std::size_t b) const {
+        if (probeHandles[a] != probeHandles[b] || chainLengths[a] != chainLengths[b]) {
+            return false;
+        }
+        const auto first = chainNames.begin() + chainOffsets[a];
+        return std::equal(first, first + chainLengths[a], chainNames.begin() + chainOffsets[b]);
+    }
+
+    bool MonitorStore::HasProbeChain(std::size_t index, const std::vector<NodeIndex::NameId>& chain) const {
+        const auto first = chainNames.begin() + chainOffsets[index];
+        return std::equal(first, first + chainLengths[index], chain.begin(), chain.end());
+    }
+
+    std::size_t MonitorStore::Add(ActorHandle probeHandle, ActorHandle targetHandle, Metadata meta,
+                                  const std::vector<NodeIndex::NameId>& chain, NodeIndex::NameId targetName,
+                                  float distanceThreshold, float restoreThreshold, const Volume& volume) {
+        const std::size_t index = Size();
+        const std::size_t chainLength = chain.size();
+
+        probeHandles.push_back(probeHandle);
+        targetHandles.push_back(targetHandle);
+        distanceThresholds.push_back(distanceThreshold);
+        restoreThresholds.push_back(restoreThreshold);
+        volumes.push_back(volume);
+        chainSpans.push_back(0.0f);
+        maxPenetrationBeyondThreshold.push_back(0.0f);
+        movedMasks.push_back(0);
+        appliedCorrections.push_back(0.0f);
+        requestedPullbacks.push_back(0.0f);
+        engaged.push_back(0);
+        restMasks.push_back(0);
+        waitingForBones.push_back(0);
+        nextEvalTicks.push_back(0);
+        penetrationHistory.emplace_back();
+        chainLengths.push_back(static_cast<std::uint8_t>(chainLength));
+        presentMasks.push_back(0);
+        loopLearners.emplace_back();
+        targetNames.push_back(targetName);
+        probeNodes.push_back(nullptr);
+        targetNodes.push_back(nullptr);
+        chainOffsets.push_back(static_cast<std::uint32_t>(chainNames.size()));
+        chainNames.insert(chainNames.end(), chain.begin(), chain.end());
+        chainRest.resize(chainNames.size());
+        metadata.push_back(std::move(meta));
+        ResetMotion(index);
+        return index;
+    }
+
+    void MonitorStore::Reset(std::size_t index, Metadata meta, const std::vector<NodeIndex::NameId>& chain,
+                             NodeIndex::NameId targetName, float distanceThreshold, float restoreThreshold,
+                             const Volume& volume) {
+        ReplaceChainRange(index, chain);
+        chainLengths[index] = static_cast<std::uint8_t>(chain.size());
+        targetNames[index] = targetName;
+
+        distanceThresholds[index] = distanceThreshold;
+        restoreThresholds[index] = restoreThreshold;
+        volumes[index] = volume;
+        chainSpans[index] = 0.0f;
+        maxPenetrationBeyondThreshold[index] = 0.0f;
+        restMasks[index] = 0;
+        engaged[index] = 0;
+        waitingForBones[index] = 0;
+        presentMasks[index] = 0;
+        ResetMotion(index);
+        metadata[index] = std::move(meta);
+        // movedMasks and the pullback are kept: with the same chain the next tick re-solves the bones it
+        // already moved. Callers changing the chain must restore those bones and clear them first.
+    }
+
+    void MonitorStore::Remove(std::size_t index) {
+        ReplaceChainRange(index, {});
+
+        const auto at = [index](auto& array) { array.erase(array.begin() + static_cast<std::ptrdiff_t>(index)); };
+        at(probeHandles);
+        at(targetHandles);
+        at(distanceThresholds);
+        at(restoreThresholds);
+        at(volumes);
+        at(chainSpans);
+        at(maxPenetrationBeyondThreshold);
+        at(movedMasks);
+        at(appliedCorrections);
+        at(requestedPullbacks);
+        at(engaged);
+        at(restMasks);
+        at(waitingForBones);
+        at(nextEvalTicks);
+        at(penetrationHistory);
+        at(chainLengths);
+        at(presentMasks);
+        at(loopLearners);
+        at(targetNames);
+        at(probeNodes);
+        at(targetNodes);
+        at(chainOffsets);
+        at(metadata);
+    }
+
+    void MonitorStore::Clear() {
+        probeHandles.clear();
+        targetHandles.clear();
+        distanceThresholds.clear();
+        restoreThresholds.clear();
+        volumes.clear();
+        chainSpans.clear();
+        maxPenetrationBeyondThreshold.clear();
+        movedMasks.clear();
+        appliedCorrections.clear();
+        requestedPullbacks.clear();
+        engaged.clear();
+        restMasks.clear();
+        waitingForBones.clear();
+        nextEvalTicks.clear();
+        penetrationHistory.clear();
+        chainLengths.clear();
+        presentMasks.clear();
+        loopLearners.clear();
+        targetNames.clear();
+        probeNodes.clear();
+        targetNodes.clear();
+        chainOffsets.clear();
+        chainNames.clear();
+        chainRest.clear();
+        metadata.clear();
+    }
+
+    void MonitorStore::ReplaceChainRange(std::size_t index, const std::vector<NodeIndex::NameId>& chain) {
+        const std::size_t oldCount = chainLengths[index];
+        const auto first = chainNames.begin() + chainOffsets[index];
+        const auto firstRest = chainRest.begin() + chainOffsets[index];
+        if (oldCount == chain.size()) {
+            std::copy(chain.begin(), chain.end(), first);
+            std::fill(firstRest, firstRest + static_cast<std::ptrdiff_t>(oldCount), BoneRest{});
+            return;
+        }
+
+        chainNames.erase(first, first + static_cast<std::ptrdiff_t>(oldCount));
+        chainNames.insert(chainNames.begin() + chainOffsets[index], chain.begin(), chain.end());
+        chainRest.erase(firstRest, firstRest + static_cast<std::ptrdiff_t>(oldCount));
+        chainRest.insert(chainRest.begin() + chainOffsets[index], chain.size(), BoneRest{});
+
+        // Shift the pool ranges of every later slot
+        const auto delta = static_cast<std::int64_t>(chain.size()) - static_cast<std::int64_t>(oldCount);
+        for (std::size_t i = index + 1; i < Size(); ++i) {
+            chainOffsets[i] = static_cast<std::uint32_t>(static_cast<std::int64_t>(chainOffsets[i]) + delta);
+        }
+    }
+
+}  // namespace KYL
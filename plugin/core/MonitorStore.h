@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "LoopLearner.h"
+#include "NodeIndex.h"
+#include "Skeleton.h"
+#include "VolumeTest.h"
+
+namespace KYL {
+
+    // Structure-of-arrays monitor registry. Everything the tick reads or writes lives in parallel
+    // contiguous arrays indexed by monitor slot; names and log-only telemetry sit in a cold side array.
+    // Bones are referenced by interned name and resolved through the shared NodeIndex; the chains of
+    // all monitors share one flat pool addressed by per-monitor offset/length.
+    class MonitorStore {
+    public:
+        // Moved middle bones are tracked as a bitmask indexed by probe chain position
+        using BoneMask = std::uint32_t;
+        static constexpr std::size_t kMaxChainLength = sizeof(BoneMask) * 8;
+
+        // Last few evaluated tip penetrations with the tick they were taken on, newest last
+        struct PenetrationHistory {
+            static constexpr std::size_t kCapacity = 4;
+            // Samples further back than this are too stale to describe the current motion
+            static constexpr std::uint64_t kMaxAgeTicks = 10;
+
+            std::array<float, kCapacity> values{};
+            std::array<std::uint64_t, kCapacity> ticks{};
+            std::uint8_t count{0};
+
+            void Push(std::uint64_t tick, float value);
+            void Clear() { count = 0; }
+            bool Empty() const { return count == 0; }
+            float Latest() const { return values[count - 1]; }
+            std::uint64_t LatestTick() const { return ticks[count - 1]; }
+
+            // Least-squares penetration change per tick over the recent samples; 0 without two samples
+            float Slope() const;
+            // Fastest change per tick between consecutive samples; stays high through a turnaround where
+            // the slope alone would suggest the tip is at rest
+            float PeakSpeed() const;
+        };
+
+        // Rest pose of one middle bone, measured while its chain is unmoved: the segment from the previous
+        // bone projected onto the probe direction, and how far the tip moves along the probe per unit of
+        // pullback along that segment (the cosine between segment and probe)
+        struct BoneRest {
+            float length{0.0f};
+            float gain{0.0f};
+        };
+
+        // Volume test of a slot (see VolumeSpec) with the target end bone interned
+        struct Volume {
+            float probeRadius{0.0f};
+            float targetRadius{0.0f};
+            NodeIndex::NameId targetEnd{0};
+            bool enabled{false};
+            // Target is a capsule to targetEnd rather than a sphere
+            bool capsule{false};
+        };
+
+        // Cold metadata: only touched on registration, lookup misses and logging
+        struct Metadata {
+            std::vector<std::string> probeNodes;
+            std::string targetNode;
+            VolumeSpec volume;
+            // Track maximum penetration depth reached
+            float maxPenetration{0.0f};
+            // Calibration cache entry the learned maxima are saved to; 0 = not cached
+            std::uint64_t calibrationKey{0};
+        };
+
+        std::size_t Size() const { return probeHandles.size(); }
+        bool Empty() const { return probeHandles.empty(); }
+
+        // Slot of the monitor matching probe/target/target node, if any
+        std::optional<std::size_t> Find(ActorHandle probeHandle, ActorHandle targetHandle,
+                                        const std::string& targetNode) const;
+
+        // Append a monitor with cleared state; chain holds the interned probe node names. Returns its slot.
+        std::size_t Add(ActorHandle probeHandle, ActorHandle targetHandle, Metadata metadata,
+                        const std::vector<NodeIndex::NameId>& chain, NodeIndex::NameId targetName,
+                        float distanceThreshold, float restoreThreshold, const Volume& volume);
+
+        // Replace chain/thresholds/volume of an existing slot and clear its learned state
+        void Reset(std::size_t index, Metadata metadata, const std::vector<NodeIndex::NameId>& chain,
+                   NodeIndex::NameId targetName, float distanceThreshold, float restoreThreshold,
+                   const Volume& volume);
+
+        // Order-preserving removal of one slot
+        void Remove(std::size_t index);
+        void Clear();
+
+        // Interned name of chain position idx (0 = base, chainLength - 1 = tip)
+        NodeIndex::NameId ChainName(std::size_t index, std::size_t idx) const { return chainNames[chainOffsets[index] + idx]; }
+        BoneRest& Rest(std::size_t index, std::size_t idx) { return chainRest[chainOffsets[index] + idx]; }
+
+        // True if both slots move the same bones: same probe actor and same probe chain
+        bool SharesProbeChain(std::size_t a, std::size_t b) const;
+        // True if the slot's probe chain is exactly chain
+        bool HasProbeChain(std::size_t index, const std::vector<NodeIndex::NameId>& chain) const;
+
+        static bool IsMoved(BoneMask mask, std::size_t idx) { return (mask >> idx) & 1u; }
+        static BoneMask BoneBit(std::size_t idx) { return BoneMask{1} << idx; }
+
+        // Make the slot due on the next tick with no motion history or learned loop
+        void ResetMotion(std::size_t index) {
+            nextEvalTicks[index] = 0;
+            penetrationHistory[index].Clear();
+            if (loopLearners[index]) {
+                loopLearners[index]->Reset();
+            }
+        }
+
+        // Hot data
+        std::vector<ActorHandle> probeHandles;
+        std::vector<ActorHandle> targetHandles;
+        std::vector<float> distanceThresholds;
+        std::vector<float> restoreThresholds;
+        std::vector<Volume> volumes;
+        // Longest probe chain, base to tip along its bones, seen by the volume test; bounds the chain for
+        // the early reject. 0 until measured.
+        std::vector<float> chainSpans;
+        // Track maximum penetration beyond threshold to minimize repeated bone updates
+        std::vector<float> maxPenetrationBeyondThreshold;
+        std::vector<BoneMask> movedMasks;
+        // Pullback along the probe that the moved bones currently apply to the tip, and the pullback that
+        // was asked of them (larger only when the chain is fully folded)
+        std::vector<float> appliedCorrections;
+        std::vector<float> requestedPullbacks;
+        // Monitor is past its shrink threshold and has not yet fallen to its restore threshold
+        std::vector<std::uint8_t> engaged;
+        // Chain positions whose rest pose has been measured
+        std::vector<BoneMask> restMasks;
+        std::vector<std::uint8_t> waitingForBones;
+        // Adaptive evaluation: tick at which the monitor is next evaluated
+        std::vector<std::uint64_t> nextEvalTicks;
+        // Recent tip penetrations for the velocity estimate and predictive correction
+        std::vector<PenetrationHistory> penetrationHistory;
+        std::vector<std::uint8_t> chainLengths;
+        // Middle bones found on the last live evaluation; loop playback reuses them without a lookup
+        std::vector<BoneMask> presentMasks;
+        // Loop learning state, allocated only while the mode is enabled
+        std::vector<std::unique_ptr<LoopLearner>> loopLearners;
+        std::vector<NodeIndex::NameId> targetNames;
+        // Node index entries of probe/target actor, resolved on first use and reset when the index is pruned
+        std::vector<NodeIndex::ActorNodes*> probeNodes;
+        std::vector<NodeIndex::ActorNodes*> targetNodes;
+        std::vector<std::uint32_t> chainOffsets;
+        std::vector<NodeIndex::NameId> chainNames;
+        // Parallel to chainNames
+        std::vector<BoneRest> chainRest;
+
+        // Cold data
+        std::vector<Metadata> metadata;
+
+    private:
+        void ReplaceChainRange(std::size_t index, const std::vector<NodeIndex::NameId>& chain);
+    };
+
+}  // namespace KYL
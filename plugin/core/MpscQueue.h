@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace KYL {
+
+    // Unbounded lock-free multi-producer single-consumer queue (intrusive linked list with a stub node).
+    // Push may be called from any thread and never blocks; TryPop/Empty must only be called by the one
+    // consumer. A push that is still in flight may be invisible to the consumer until it completes.
+    template <class T>
+    class MpscQueue {
+    public:
+        MpscQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+
+        ~MpscQueue() {
+            T discarded;
+            while (TryPop(discarded)) {
+            }
+            if (m_tail != &m_stub) {
+                delete m_tail;
+            }
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        void Push(T value) {
+            auto* node = new Node;
+            node->value = std::move(value);
+
+            // Claim the head, then link the previous head to us; the consumer waits for the link
+            Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        bool TryPop(T& out) {
+            Node* tail = m_tail;
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (!next) {
+                return false;
+            }
+
+            // The popped node becomes the new stub; its moved-from value is never read again
+            out = std::move(next->value);
+            m_tail = next;
+            if (tail != &m_stub) {
+                delete tail;
+            }
+            return true;
+        }
+
+        bool Empty() const { return m_tail->next.load(std::memory_order_acquire) == nullptr; }
+
+    private:
+        struct Node {
+            std::atomic<Node*> next{nullptr};
+            T value{};
+        };
+
+        std::atomic<Node*> m_head;
+        Node* m_tail;
+        Node m_stub;
+    };
+
+}  // namespace KYL
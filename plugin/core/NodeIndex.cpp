@@ -0,0 +1,51 @@
+#include "NodeIndex.h"
+
+namespace KYL {
+
+    NodeIndex::NameId NodeIndex::Intern(const std::string& name) {
+        if (const auto it = m_ids.find(name); it != m_ids.end()) {
+            return it->second;
+        }
+
+        const auto id = static_cast<NameId>(m_names.size());
+        m_names.push_back(name);
+        m_ids.emplace(name, id);
+        return id;
+    }
+
+    NodeIndex::ActorNodes& NodeIndex::ForActor(ActorHandle actor) {
+        auto& entry = m_actors[actor];
+        entry.m_handle = actor;
+        return entry;
+    }
+
+    NodeRef NodeIndex::Resolve(ActorNodes& actor, NameId name) {
+        if (name >= actor.m_slots.size()) {
+            actor.m_slots.resize(m_names.size());
+        }
+
+        auto& slot = actor.m_slots[name];
+        if (slot.node) {
+            return slot.node.get();
+        }
+        if (slot.searched && m_tick < slot.retryTick) {
+            return nullptr;
+        }
+
+        slot.node = NodePtr(&m_skeleton, m_skeleton.FindNode(actor.m_handle, m_names[name]));
+        slot.searched = true;
+        slot.retryTick = m_tick + kMissRetryTicks;
+        if (!slot.node) {
+            ++m_misses;
+        }
+        return slot.node.get();
+    }
+
+    void NodeIndex::Invalidate(ActorHandle actor) {
+        // Keep the entry itself so references handed out by ForActor stay valid
+        if (const auto it = m_actors.find(actor); it != m_actors.end()) {
+            it->second.m_slots.clear();
+        }
+    }
+
+}  // namespace KYL
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Skeleton.h"
+
+namespace KYL {
+
+    // Per-actor cache of resolved skeleton nodes shared by every monitor, keyed by actor handle and
+    // interned bone name. A name is searched in the skeleton once per actor; after that a lookup is a
+    // vector index. Entries stay valid until the actor's 3D is (re)loaded or unloaded, which the
+    // adapter reports through Invalidate. Bones that are missing are retried every kMissRetryTicks
+    // ticks so monitors waiting for a late-attached mesh do not search the tree on every tick.
+    // Not thread-safe: owned by the thread that ticks the monitors.
+    class NodeIndex {
+    public:
+        using NameId = std::uint32_t;
+        static constexpr std::uint32_t kMissRetryTicks = 20;
+
+        class ActorNodes {
+        public:
+            ActorHandle Handle() const { return m_handle; }
+
+        private:
+            friend class NodeIndex;
+
+            struct Slot {
+                NodePtr node;
+                bool searched{false};
+                std::uint32_t retryTick{0};
+            };
+
+            ActorHandle m_handle{0};
+            std::vector<Slot> m_slots;
+        };
+
+        explicit NodeIndex(ISkeleton& skeleton) : m_skeleton(skeleton) {}
+
+        NameId Intern(const std::string& name);
+        const std::string& GetName(NameId id) const { return m_names[id]; }
+
+        // Skeleton searches that found nothing, including retries
+        std::uint64_t GetMissCount() const { return m_misses; }
+
+        // Advance the miss-retry clock; call once per tick
+        void BeginTick() { ++m_tick; }
+
+        // Entry for an actor, created empty on first use. The reference stays valid until the actor is
+        // pruned or the index is cleared.
+        ActorNodes& ForActor(ActorHandle actor);
+
+        NodeRef Resolve(ActorNodes& actor, NameId name);
+        NodeRef Resolve(ActorHandle actor, NameId name) { return Resolve(ForActor(actor), name); }
+
+        // Drop every cached node of the actor (3D loaded/unloaded); its entry stays valid
+        void Invalidate(ActorHandle actor);
+
+        // Drop actors no longer referenced by any monitor; invalidates their ForActor references
+        template <class IsReferenced>
+        void Prune(IsReferenced isReferenced) {
+            std::erase_if(m_actors, [&](const auto& entry) { return !isReferenced(entry.first); });
+        }
+
+        void Clear() { m_actors.clear(); }
+
+    private:
+        ISkeleton& m_skeleton;
+        std::unordered_map<std::string, NameId> m_ids;
+        std::vector<std::string> m_names;
+        std::unordered_map<ActorHandle, ActorNodes> m_actors;
+        std::uint32_t m_tick{0};
+        std::uint64_t m_misses{0};
+    };
+
+}  // namespace KYL
@@ -0,0 +1,182 @@
+#include "PenetrationKernel.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define KYL_KERNEL_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define KYL_TARGET_AVX2
+    #else
+        #define KYL_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#else
+    #define KYL_KERNEL_X86 0
+#endif
+
+namespace KYL {
+
+    namespace {
+        // Same operation order as the original Vector3 math: (tip - base) / |tip - base|, then a
+        // left-to-right dot product, so the SIMD paths reproduce it lane for lane
+        void ComputeLanesScalar(const PenetrationBatch& batch, std::size_t begin) {
+            for (std::size_t i = begin; i < batch.count; ++i) {
+                const float dx = batch.tipX[i] - batch.baseX[i];
+                const float dy = batch.tipY[i] - batch.baseY[i];
+                const float dz = batch.tipZ[i] - batch.baseZ[i];
+                const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+                const float nx = dx / length;
+                const float ny = dy / length;
+                const float nz = dz / length;
+
+                const float tx = batch.tipX[i] - batch.targetX[i];
+                const float ty = batch.tipY[i] - batch.targetY[i];
+                const float tz = batch.tipZ[i] - batch.targetZ[i];
+
+                batch.directionX[i] = nx;
+                batch.directionY[i] = ny;
+                batch.directionZ[i] = nz;
+                batch.probeLength[i] = length;
+                batch.tipPenetration[i] = tx * nx + ty * ny + tz * nz;
+            }
+        }
+
+#if KYL_KERNEL_X86
+        void ComputeLanesSse(const PenetrationBatch& batch) {
+            std::size_t i = 0;
+            for (; i + 4 <= batch.count; i += 4) {
+                const __m128 tipX = _mm_loadu_ps(batch.tipX + i);
+                const __m128 tipY = _mm_loadu_ps(batch.tipY + i);
+                const __m128 tipZ = _mm_loadu_ps(batch.tipZ + i);
+
+                const __m128 dx = _mm_sub_ps(tipX, _mm_loadu_ps(batch.baseX + i));
+                const __m128 dy = _mm_sub_ps(tipY, _mm_loadu_ps(batch.baseY + i));
+                const __m128 dz = _mm_sub_ps(tipZ, _mm_loadu_ps(batch.baseZ + i));
+                const __m128 lengthSq =
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                const __m128 length = _mm_sqrt_ps(lengthSq);
+
+                const __m128 nx = _mm_div_ps(dx, length);
+                const __m128 ny = _mm_div_ps(dy, length);
+                const __m128 nz = _mm_div_ps(dz, length);
+
+                const __m128 tx = _mm_sub_ps(tipX, _mm_loadu_ps(batch.targetX + i));
+                const __m128 ty = _mm_sub_ps(tipY, _mm_loadu_ps(batch.targetY + i));
+                const __m128 tz = _mm_sub_ps(tipZ, _mm_loadu_ps(batch.targetZ + i));
+                const __m128 penetration =
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, nx), _mm_mul_ps(ty, ny)), _mm_mul_ps(tz, nz));
+
+                _mm_storeu_ps(batch.directionX + i, nx);
+                _mm_storeu_ps(batch.directionY + i, ny);
+                _mm_storeu_ps(batch.directionZ + i, nz);
+                _mm_storeu_ps(batch.probeLength + i, length);
+                _mm_storeu_ps(batch.tipPenetration + i, penetration);
+            }
+            ComputeLanesScalar(batch, i);
+        }
+
+        KYL_TARGET_AVX2 void ComputeLanesAvx2(const PenetrationBatch& batch) {
+            std::size_t i = 0;
+            for (; i + 8 <= batch.count; i += 8) {
+                const __m256 tipX = _mm256_loadu_ps(batch.tipX + i);
+                const __m256 tipY = _mm256_loadu_ps(batch.tipY + i);
+                const __m256 tipZ = _mm256_loadu_ps(batch.tipZ + i);
+
+                const __m256 dx = _mm256_sub_ps(tipX, _mm256_loadu_ps(batch.baseX + i));
+                const __m256 dy = _mm256_sub_ps(tipY, _mm256_loadu_ps(batch.baseY + i));
+                const __m256 dz = _mm256_sub_ps(tipZ, _mm256_loadu_ps(batch.baseZ + i));
+                const __m256 lengthSq =
+                    _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+                const __m256 length = _mm256_sqrt_ps(lengthSq);
+
+                const __m256 nx = _mm256_div_ps(dx, length);
+                const __m256 ny = _mm256_div_ps(dy, length);
+                const __m256 nz = _mm256_div_ps(dz, length);
+
+                const __m256 tx = _mm256_sub_ps(tipX, _mm256_loadu_ps(batch.targetX + i));
+                const __m256 ty = _mm256_sub_ps(tipY, _mm256_loadu_ps(batch.targetY + i));
+                const __m256 tz = _mm256_sub_ps(tipZ, _mm256_loadu_ps(batch.targetZ + i));
+                const __m256 penetration =
+                    _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, nx), _mm256_mul_ps(ty, ny)), _mm256_mul_ps(tz, nz));
+
+                _mm256_storeu_ps(batch.directionX + i, nx);
+                _mm256_storeu_ps(batch.directionY + i, ny);
+                _mm256_storeu_ps(batch.directionZ + i, nz);
+                _mm256_storeu_ps(batch.probeLength + i, length);
+                _mm256_storeu_ps(batch.tipPenetration + i, penetration);
+            }
+            ComputeLanesScalar(batch, i);
+        }
+
+        bool CpuSupportsAvx2() {
+    #if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+
+            // AVX state must be enabled by the OS (OSXSAVE + XCR0 YMM bits)
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+                return false;
+            }
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+    #else
+            return __builtin_cpu_supports("avx2");
+    #endif
+        }
+#endif
+
+        using KernelFn = void (*)(const PenetrationBatch&);
+
+        void ComputeScalar(const PenetrationBatch& batch) { ComputeLanesScalar(batch, 0); }
+
+        KernelFn SelectKernel(KernelIsa isa) {
+            switch (isa) {
+#if KYL_KERNEL_X86
+                case KernelIsa::AVX2:
+                    return ComputeLanesAvx2;
+                case KernelIsa::SSE:
+                    return ComputeLanesSse;
+#endif
+                default:
+                    return ComputeScalar;
+            }
+        }
+    }
+
+    const char* GetKernelIsaName(KernelIsa isa) {
+        switch (isa) {
+            case KernelIsa::AVX2:
+                return "AVX2";
+            case KernelIsa::SSE:
+                return "SSE";
+            default:
+                return "Scalar";
+        }
+    }
+
+    KernelIsa DetectKernelIsa() {
+#if KYL_KERNEL_X86
+        // SSE2 is part of the x86-64 baseline
+        return CpuSupportsAvx2() ? KernelIsa::AVX2 : KernelIsa::SSE;
+#else
+        return KernelIsa::Scalar;
+#endif
+    }
+
+    void ComputePenetration(const PenetrationBatch& batch, KernelIsa isa) { SelectKernel(isa)(batch); }
+
+    void ComputePenetration(const PenetrationBatch& batch) {
+        static const KernelFn kernel = SelectKernel(DetectKernelIsa());
+        kernel(batch);
+    }
+
+}  // namespace KYL
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+
+namespace KYL {
+
+    // Gathered inputs and outputs for a batch of monitors, one structure-of-arrays lane per monitor.
+    // For every lane the kernel computes the normalized base -> tip probe direction, the probe length
+    // and the tip penetration (tip - target projected onto the direction). Lanes with a degenerate
+    // probe (length near zero) produce meaningless direction/penetration; callers check probeLength.
+    struct PenetrationBatch {
+        std::size_t count{0};
+
+        const float* baseX{nullptr};
+        const float* baseY{nullptr};
+        const float* baseZ{nullptr};
+        const float* tipX{nullptr};
+        const float* tipY{nullptr};
+        const float* tipZ{nullptr};
+        const float* targetX{nullptr};
+        const float* targetY{nullptr};
+        const float* targetZ{nullptr};
+
+        float* directionX{nullptr};
+        float* directionY{nullptr};
+        float* directionZ{nullptr};
+        float* probeLength{nullptr};
+        float* tipPenetration{nullptr};
+    };
+
+    enum class KernelIsa { Scalar, SSE, AVX2 };
+
+    const char* GetKernelIsaName(KernelIsa isa);
+
+    // Best instruction set supported by the running CPU
+    KernelIsa DetectKernelIsa();
+
+    // Run the batch with a specific implementation (ISA must be supported by the CPU)
+    void ComputePenetration(const PenetrationBatch& batch, KernelIsa isa);
+
+    // Run the batch with the implementation picked at runtime on first use
+    void ComputePenetration(const PenetrationBatch& batch);
+
+}  // namespace KYL
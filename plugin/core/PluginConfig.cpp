@@ -0,0 +1,262 @@
+#include "PluginConfig.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#include "Json.h"
+#include "Logger.h"
+
+namespace KYL {
+
+    namespace {
+        constexpr std::array<std::string_view, kActionTypeCount> kActionNames{"oral", "vaginal", "anal"};
+        constexpr std::array<std::string_view, kActionTypeCount> kDefaultBones{"NPC Head [Head]", "NPC Pelvis [Pelv]",
+                                                                               "NPC Spine [Spn0]"};
+
+        char ToLower(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+        bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+            return a.size() == b.size() &&
+                   std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return ToLower(x) == ToLower(y); });
+        }
+
+        std::optional<ActionType> Lookup(const std::unordered_map<std::string, ActionType>& types,
+                                         std::string_view name) {
+            const auto it = types.find(ToLowerAscii(name));
+            return it != types.end() ? std::optional{it->second} : std::nullopt;
+        }
+
+        // Non-string elements are skipped; a missing or non-array value leaves names untouched
+        void ReadStrings(const JsonValue* value, std::vector<std::string>& names) {
+            if (!value || !value->IsArray()) {
+                return;
+            }
+            names.clear();
+            for (const auto& item : value->Items()) {
+                if (item.GetType() == JsonValue::Type::String) {
+                    names.push_back(item.AsString(""));
+                }
+            }
+        }
+
+        float ReadFloat(const JsonValue& object, std::string_view key, float fallback) {
+            const auto* value = object.Find(key);
+            return value ? static_cast<float>(value->AsNumber(fallback)) : fallback;
+        }
+
+        // Saturates at the int range: converting a double outside it is undefined behavior
+        int ReadInt(const JsonValue& object, std::string_view key, int fallback) {
+            const auto* value = object.Find(key);
+            if (!value) {
+                return fallback;
+            }
+            const double number = value->AsNumber(fallback);
+            if (!std::isfinite(number)) {
+                return fallback;
+            }
+            return static_cast<int>(std::clamp(number, static_cast<double>(std::numeric_limits<int>::min()),
+                                               static_cast<double>(std::numeric_limits<int>::max())));
+        }
+
+        std::optional<std::string> ReadFile(const std::filesystem::path& path) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                return std::nullopt;
+            }
+            return std::string{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        }
+    }
+
+    std::string ToLowerAscii(std::string_view text) {
+        std::string result(text);
+        std::transform(result.begin(), result.end(), result.begin(), ToLower);
+        return result;
+    }
+
+    std::string_view GetActionTypeName(ActionType type) { return kActionNames[static_cast<std::size_t>(type)]; }
+
+    std::optional<ActionType> ParseActionType(std::string_view name) {
+        while (name.starts_with('.')) {
+            name.remove_prefix(1);
+        }
+        for (std::size_t i = 0; i < kActionTypeCount; ++i) {
+            if (EqualsIgnoreCase(name, kActionNames[i])) {
+                return static_cast<ActionType>(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+    PluginConfig::PluginConfig() {
+        for (std::size_t i = 0; i < kActionTypeCount; ++i) {
+            actions[i].bone = kDefaultBones[i];
+        }
+    }
+
+    std::optional<ActionType> PluginConfig::FindOStimAction(std::string_view actionName) const {
+        return Lookup(m_ostimActionTypes, actionName);
+    }
+
+    std::optional<ActionType> PluginConfig::FindSexlabTag(std::string_view tagName) const {
+        return Lookup(m_sexlabTagTypes, tagName);
+    }
+
+    void PluginConfig::BuildLookups() {
+        m_ostimActionTypes.clear();
+        m_sexlabTagTypes.clear();
+        for (std::size_t i = 0; i < kActionTypeCount; ++i) {
+            const auto type = static_cast<ActionType>(i);
+            for (const auto& name : actions[i].ostimActions) {
+                m_ostimActionTypes.try_emplace(ToLowerAscii(name), type);
+            }
+            for (const auto& name : actions[i].sexlabTags) {
+                m_sexlabTagTypes.try_emplace(ToLowerAscii(name), type);
+            }
+        }
+    }
+
+    std::optional<PluginConfig> PluginConfig::Parse(std::string_view text, std::string& error) {
+        const auto document = JsonValue::Parse(text, error);
+        if (!document) {
+            return std::nullopt;
+        }
+        if (!document->IsObject()) {
+            error = "top-level value is not an object";
+            return std::nullopt;
+        }
+
+        PluginConfig config;
+        if (const auto* general = document->Find("general"); general && general->IsObject()) {
+            config.general.intervalMs = ReadInt(*general, "intervalMs", config.general.intervalMs);
+            config.general.frameDivisor = ReadInt(*general, "frameDivisor", config.general.frameDivisor);
+            config.general.lookAheadTicks = ReadFloat(*general, "lookAheadTicks", config.general.lookAheadTicks);
+            if (const auto* loopLearning = general->Find("loopLearning")) {
+                config.general.loopLearning = loopLearning->AsBool(config.general.loopLearning);
+            }
+        }
+
+        ReadStrings(document->Find("penisBones"), config.penisBones);
+
+        for (std::size_t i = 0; i < kActionTypeCount; ++i) {
+            const auto* block = document->Find(kActionNames[i]);
+            if (!block || !block->IsObject()) {
+                continue;
+            }
+            auto& action = config.actions[i];
+            action.threshold = ReadFloat(*block, "threshold", action.threshold);
+            action.restoreThreshold = ReadFloat(*block, "restoreThreshold", action.restoreThreshold);
+            ReadStrings(block->Find("ostimActions"), action.ostimActions);
+            ReadStrings(block->Find("sexlabTags"), action.sexlabTags);
+            if (const auto* bone = block->Find("bone")) {
+                action.bone = bone->AsString(action.bone);
+            }
+            action.volume.probeRadius = std::max(ReadFloat(*block, "probeRadius", action.volume.probeRadius), 0.0f);
+            action.volume.targetRadius = std::max(ReadFloat(*block, "targetRadius", action.volume.targetRadius), 0.0f);
+            if (const auto* targetEnd = block->Find("targetEndBone")) {
+                action.volume.targetEndNode = targetEnd->AsString(action.volume.targetEndNode);
+            }
+        }
+        config.BuildLookups();
+        return config;
+    }
+
+    ConfigStore::~ConfigStore() { Close(); }
+
+    bool ConfigStore::Open(std::filesystem::path path, ReloadCallback onReload) {
+        Close();
+
+        m_path = std::move(path);
+        m_onReload = std::move(onReload);
+        const bool loaded = Load();
+
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_stopRequested = false;
+        }
+        m_watcher = std::thread([this]() { WatcherMain(); });
+        return loaded;
+    }
+
+    void ConfigStore::Close() {
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_stopRequested = true;
+        }
+        m_wake.notify_all();
+        if (m_watcher.joinable()) {
+            m_watcher.join();
+        }
+    }
+
+    bool ConfigStore::Reload() { return Load(); }
+
+    std::shared_ptr<const PluginConfig> ConfigStore::Get() const {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_config;
+    }
+
+    std::optional<std::filesystem::file_time_type> ConfigStore::GetWriteTime() const {
+        std::error_code ec;
+        const auto time = std::filesystem::last_write_time(m_path, ec);
+        return ec ? std::nullopt : std::optional{time};
+    }
+
+    bool ConfigStore::Load() {
+        std::lock_guard<std::mutex> loadLock(m_loadMutex);
+
+        // Remember the attempt even if it fails so a broken file is reported once, not every poll
+        m_loadedWriteTime = GetWriteTime();
+
+        const auto text = ReadFile(m_path);
+        if (!text) {
+            LOG_WARN("Config: cannot read {}, keeping previous values", m_path.string());
+            return false;
+        }
+
+        std::string error;
+        auto parsed = PluginConfig::Parse(*text, error);
+        if (!parsed) {
+            LOG_ERROR("Config: {} is invalid ({}), keeping previous values", m_path.string(), error);
+            return false;
+        }
+
+        auto config = std::make_shared<const PluginConfig>(std::move(*parsed));
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_config = config;
+        }
+        LOG_INFO("Config: loaded {} ({} penis bone(s))", m_path.string(), config->penisBones.size());
+
+        if (m_onReload) {
+            m_onReload(*config);
+        }
+        return true;
+    }
+
+    void ConfigStore::WatcherMain() {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        while (!m_stopRequested) {
+            if (m_wake.wait_for(lk, kPollInterval, [this]() { return m_stopRequested; })) {
+                break;
+            }
+
+            lk.unlock();
+            bool changed = false;
+            {
+                std::lock_guard<std::mutex> loadLock(m_loadMutex);
+                changed = GetWriteTime() != m_loadedWriteTime;
+            }
+            if (changed) {
+                LOG_INFO("Config: {} changed, reloading", m_path.string());
+                Load();
+            }
+            lk.lock();
+        }
+    }
+
+}  // namespace KYL
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "VolumeTest.h"
+
+namespace KYL {
+
+    // Interaction kinds with their own block in config.json
+    enum class ActionType { Oral, Vaginal, Anal };
+
+    inline constexpr std::size_t kActionTypeCount = 3;
+
+    // Block name ("oral", "vaginal", "anal"); always a null-terminated literal
+    std::string_view GetActionTypeName(ActionType type);
+
+    // Accepts the block name with or without the leading dots the Papyrus JsonUtil paths use (".oral")
+    std::optional<ActionType> ParseActionType(std::string_view name);
+
+    // Defaults match the JsonUtil getters in TTKYL_Utils.psc so a missing key behaves the same natively
+    struct GeneralConfig {
+        int intervalMs{50};
+        int frameDivisor{0};
+        float lookAheadTicks{0.0f};
+        bool loopLearning{false};
+    };
+
+    struct ActionConfig {
+        float threshold{5.0f};
+        float restoreThreshold{-5.0f};
+        std::vector<std::string> ostimActions;
+        std::vector<std::string> sexlabTags;
+        std::string bone;  // target node on the receiving actor
+        // probeRadius / targetRadius / targetEndBone keys; disabled unless one of them is set
+        VolumeSpec volume;
+    };
+
+    // Parsed config.json
+    struct PluginConfig {
+        GeneralConfig general;
+        std::vector<std::string> penisBones;
+        std::array<ActionConfig, kActionTypeCount> actions;
+
+        PluginConfig();
+
+        const ActionConfig& GetAction(ActionType type) const { return actions[static_cast<std::size_t>(type)]; }
+
+        // Action type listing the OStim action / SexLab tag; names compare case-insensitively like Papyrus strings
+        std::optional<ActionType> FindOStimAction(std::string_view actionName) const;
+        std::optional<ActionType> FindSexlabTag(std::string_view tagName) const;
+
+        // Missing keys keep their defaults; a document that is not valid JSON is an error
+        static std::optional<PluginConfig> Parse(std::string_view text, std::string& error);
+
+        // Rebuild the name lookups after editing the action lists (Parse does this itself)
+        void BuildLookups();
+
+    private:
+        // Lower-cased OStim action / SexLab tag -> type; the first block listing a name wins
+        std::unordered_map<std::string, ActionType> m_ostimActionTypes;
+        std::unordered_map<std::string, ActionType> m_sexlabTagTypes;
+    };
+
+    // ASCII lower-case copy; config names and scene ids compare case-insensitively like Papyrus strings
+    std::string ToLowerAscii(std::string_view text);
+
+    // Holds the current config and reloads it when the file changes. Readers get an immutable snapshot,
+    // so a reload never changes values under a caller that is still using the previous one.
+    class ConfigStore {
+    public:
+        using ReloadCallback = std::function<void(const PluginConfig&)>;
+
+        ConfigStore() = default;
+        ~ConfigStore();
+
+        ConfigStore(const ConfigStore&) = delete;
+        ConfigStore& operator=(const ConfigStore&) = delete;
+
+        // Load path and start watching it; onReload runs on the loading thread for the initial load and
+        // on the watcher thread for later changes. Returns false if the initial load failed, in which
+        // case defaults are served until the file becomes readable.
+        bool Open(std::filesystem::path path, ReloadCallback onReload);
+
+        // Stop watching; the last loaded config stays available
+        void Close();
+
+        // Re-read the file now; a file that fails to parse keeps the previous config
+        bool Reload();
+
+        std::shared_ptr<const PluginConfig> Get() const;
+
+    private:
+        // Polling keeps the watcher portable; config edits are rare and a second of latency is fine
+        static constexpr auto kPollInterval = std::chrono::seconds{1};
+
+        bool Load();
+        std::optional<std::filesystem::file_time_type> GetWriteTime() const;
+        void WatcherMain();
+
+        std::filesystem::path m_path;
+        ReloadCallback m_onReload;
+
+        mutable std::mutex m_mutex;
+        std::shared_ptr<const PluginConfig> m_config{std::make_shared<const PluginConfig>()};
+        std::optional<std::filesystem::file_time_type> m_loadedWriteTime;
+
+        // Serializes loads from Reload and the watcher so callbacks run in file order
+        std::mutex m_loadMutex;
+
+        std::thread m_watcher;
+        std::condition_variable m_wake;
+        bool m_stopRequested{false};
+    };
+
+}  // namespace KYL
@@ -0,0 +1,147 @@
+#include "SampleRecorder.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "Logger.h"
+
+namespace KYL {
+
+    SampleRecorder::SampleRecorder(std::size_t capacity) {
+        capacity = std::bit_ceil(std::max<std::size_t>(capacity, 2));
+        m_ring = std::make_unique<TickSample[]>(capacity);
+        m_mask = capacity - 1;
+    }
+
+    SampleRecorder::~SampleRecorder() { Stop(); }
+
+    bool SampleRecorder::Start(const std::filesystem::path& path) {
+        Stop();
+
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_file) {
+            LOG_ERROR("Sample recorder: cannot create {}", path.string());
+            return false;
+        }
+        const FileHeader header{kMagic, kVersion, sizeof(TickSample), 0};
+        m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        // This thread is the only consumer while the writer is stopped: skip whatever an earlier
+        // recording left behind
+        m_startHead = m_head.load(std::memory_order_acquire);
+        m_tail.store(m_startHead, std::memory_order_release);
+        m_dropped.store(0, std::memory_order_relaxed);
+        m_written = 0;
+        m_startTime.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+
+        m_stopRequested = false;
+        m_writer = std::thread([this]() { WriterMain(); });
+        m_recording.store(true, std::memory_order_release);
+        LOG_INFO("Sample recorder: recording to {}", path.string());
+        return true;
+    }
+
+    void SampleRecorder::Stop() {
+        m_recording.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_stopRequested = true;
+        }
+        m_wake.notify_all();
+        if (m_writer.joinable()) {
+            m_writer.join();
+        }
+
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_file.is_open()) {
+            Drain();
+            m_file.close();
+            LOG_INFO("Sample recorder: stopped, {} sample(s) written, {} dropped", m_written,
+                     m_dropped.load(std::memory_order_relaxed));
+        }
+    }
+
+    std::uint64_t SampleRecorder::ElapsedMicros() const {
+        const std::chrono::steady_clock::duration elapsed{
+            std::chrono::steady_clock::now().time_since_epoch().count() -
+            m_startTime.load(std::memory_order_relaxed)};
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+
+    void SampleRecorder::Record(const TickSample& sample) {
+        if (!m_recording.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_ring[head & m_mask] = sample;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    SampleRecorder::Stats SampleRecorder::GetStats() const {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return {m_head.load(std::memory_order_acquire) - m_startHead, m_dropped.load(std::memory_order_relaxed),
+                m_written};
+    }
+
+    bool SampleRecorder::ReadFile(const std::filesystem::path& path, std::vector<TickSample>& samples,
+                                  std::string& error) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            error = "cannot open " + path.string();
+            return false;
+        }
+
+        FileHeader header{};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != kMagic) {
+            error = path.string() + " is not a sample recording";
+            return false;
+        }
+        if (header.version != kVersion || header.recordSize != sizeof(TickSample)) {
+            error = path.string() + " was written by an incompatible version";
+            return false;
+        }
+
+        // A partial record at the end (recording cut off mid-write) is ignored
+        samples.clear();
+        TickSample sample;
+        while (file.read(reinterpret_cast<char*>(&sample), sizeof(sample))) {
+            samples.push_back(sample);
+        }
+        return true;
+    }
+
+    void SampleRecorder::Drain() {
+        const std::uint64_t head = m_head.load(std::memory_order_acquire);
+        std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        while (tail != head) {
+            // Contiguous run up to the head or the end of the ring
+            const std::size_t first = tail & m_mask;
+            const std::size_t count = std::min<std::uint64_t>(head - tail, m_mask + 1 - first);
+            m_file.write(reinterpret_cast<const char*>(&m_ring[first]),
+                         static_cast<std::streamsize>(count * sizeof(TickSample)));
+            tail += count;
+            m_written += count;
+        }
+        m_tail.store(tail, std::memory_order_release);
+
+        if (!m_file && m_recording.exchange(false, std::memory_order_relaxed)) {
+            LOG_ERROR("Sample recorder: write failed, recording stopped");
+        }
+    }
+
+    void SampleRecorder::WriterMain() {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        while (!m_stopRequested) {
+            m_wake.wait_for(lk, kFlushInterval, [this]() { return m_stopRequested; });
+            Drain();
+            m_file.flush();
+        }
+    }
+
+}  // namespace KYL
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Skeleton.h"
+#include "Vector3.h"
+
+namespace KYL {
+
+    // What an evaluation did with the probe's middle bones
+    enum class SampleAction : std::uint8_t {
+        Hold,     // between the thresholds: bones keep their state
+        Shrink,   // above the shrink threshold: bones moved (or kept) at offset
+        Restore,  // at or below the restore threshold: moved bones put back
+    };
+
+    // Where the tip penetration of a sample came from
+    enum class SampleSource : std::uint8_t {
+        Live,      // read from the skeleton; positions are valid
+        Playback,  // learned loop table; no bone was read and positions are zero
+    };
+
+    // One evaluated monitor on one tick, written to the file as is
+    struct TickSample {
+        std::uint64_t tick{0};
+        // Microseconds since the recording started
+        std::uint64_t timeUs{0};
+        ActorHandle probeHandle{0};
+        ActorHandle targetHandle{0};
+        // Registry slot; tells apart monitors of the same actor pair while the monitor set is unchanged
+        std::uint32_t monitor{0};
+        // Middle bones moved after the evaluation, bit per chain position
+        std::uint32_t movedMask{0};
+        Vector3 base;
+        Vector3 tip;
+        Vector3 target;
+        // Overlap depth for monitors using the volume test
+        float tipPenetration{0.0f};
+        // Tip penetration extrapolated by the look-ahead; what the shrink decision compared
+        float predictedPenetration{0.0f};
+        float distanceThreshold{0.0f};
+        float restoreThreshold{0.0f};
+        // Largest per-bone offset applied while shrinking, 0 otherwise
+        float offset{0.0f};
+        SampleAction action{SampleAction::Hold};
+        SampleSource source{SampleSource::Live};
+        // Probe bones including base and tip
+        std::uint8_t chainLength{0};
+        std::uint8_t reserved[5]{};
+    };
+    static_assert(sizeof(TickSample) == 96);
+
+    // Opt-in per-tick recorder for tuning thresholds offline. The ticking thread copies fixed-size samples
+    // into a lock-free single-producer ring; a writer thread drains it to a binary file every
+    // kFlushInterval. Recording never blocks or allocates: a full ring drops new samples and counts them.
+    //
+    // Record must only be called from one thread at a time (the engine's ticking thread); Start and Stop
+    // from one control thread.
+    class SampleRecorder {
+    public:
+        // File layout: header, then TickSample records back to back in native byte order
+        struct FileHeader {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t recordSize;
+            std::uint32_t reserved;
+        };
+        static constexpr std::uint32_t kMagic = 0x534C594B;  // "KYLS"
+        static constexpr std::uint32_t kVersion = 1;
+
+        // About 3 seconds of 300 monitors at 20 ticks/s; the writer drains far more often
+        static constexpr std::size_t kDefaultCapacity = 1 << 15;
+
+        struct Stats {
+            std::uint64_t recorded{0};
+            std::uint64_t dropped{0};
+            std::uint64_t written{0};
+        };
+
+        // capacity is rounded up to a power of two; the ring is allocated once here
+        explicit SampleRecorder(std::size_t capacity = kDefaultCapacity);
+        ~SampleRecorder();
+
+        SampleRecorder(const SampleRecorder&) = delete;
+        SampleRecorder& operator=(const SampleRecorder&) = delete;
+
+        // Create path (truncating it) and start recording; samples recorded before are discarded
+        bool Start(const std::filesystem::path& path);
+
+        // Write what is buffered, close the file and stop the writer thread
+        void Stop();
+
+        bool IsRecording() const { return m_recording.load(std::memory_order_acquire); }
+
+        // Microseconds since Start; the engine stamps a whole pass with one reading
+        std::uint64_t ElapsedMicros() const;
+
+        // Queue a sample for writing; a no-op when not recording
+        void Record(const TickSample& sample);
+
+        // Stats of the current or last recording
+        Stats GetStats() const;
+
+        // Read a whole recording; false with error set if the file is missing or not a sample file
+        static bool ReadFile(const std::filesystem::path& path, std::vector<TickSample>& samples,
+                             std::string& error);
+
+    private:
+        static constexpr auto kFlushInterval = std::chrono::milliseconds{100};
+
+        void Drain();
+        void WriterMain();
+
+        std::unique_ptr<TickSample[]> m_ring;
+        std::size_t m_mask{0};
+
+        // Producer and consumer positions on separate cache lines; both only grow
+        alignas(64) std::atomic<std::uint64_t> m_head{0};
+        alignas(64) std::atomic<std::uint64_t> m_tail{0};
+        alignas(64) std::atomic<std::uint64_t> m_dropped{0};
+
+        std::atomic<bool> m_recording{false};
+        // steady_clock count at Start; atomic because the ticking thread reads it
+        std::atomic<std::chrono::steady_clock::rep> m_startTime{0};
+
+        // Guards the file and the writer thread state
+        mutable std::mutex m_mutex;
+        std::ofstream m_file;
+        std::uint64_t m_startHead{0};
+        std::uint64_t m_written{0};
+        std::thread m_writer;
+        std::condition_variable m_wake;
+        bool m_stopRequested{false};
+    };
+
+}  // namespace KYL
@@ -0,0 +1,77 @@
+#include "ScenePlanCache.h"
+
+#include <utility>
+
+namespace KYL {
+
+    ScenePlan ScenePlanCache::Compile(const std::vector<SceneAction>& actions,
+                                      const std::shared_ptr<const PluginConfig>& config) {
+        ScenePlan plan;
+        plan.config = config;
+        plan.probeNodes = config->penisBones;
+
+        for (const auto& action : actions) {
+            const auto type = config->FindOStimAction(action.name);
+            if (!type) {
+                continue;
+            }
+
+            const auto& block = config->GetAction(*type);
+            ScenePlan::Entry& entry = plan.entries.emplace_back();
+            entry.type = *type;
+            // The action actor penetrates, except in oral actions where the target does
+            const bool targetIsProbe = *type == ActionType::Oral;
+            entry.probeSlot = targetIsProbe ? action.targetSlot : action.actorSlot;
+            entry.targetSlot = targetIsProbe ? action.actorSlot : action.targetSlot;
+            entry.threshold = block.threshold;
+            entry.restoreThreshold = block.restoreThreshold;
+            entry.targetNode = block.bone;
+            entry.volume = block.volume;
+        }
+        return plan;
+    }
+
+    void ScenePlanCache::Define(std::string_view sceneId, std::vector<SceneAction> actions) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        auto& scene = m_scenes[ToLowerAscii(sceneId)];
+        scene.actions = std::move(actions);
+        scene.plan.reset();
+        m_stats.scenes = m_scenes.size();
+    }
+
+    bool ScenePlanCache::Contains(std::string_view sceneId) const {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_scenes.contains(ToLowerAscii(sceneId));
+    }
+
+    std::shared_ptr<const ScenePlan> ScenePlanCache::Get(std::string_view sceneId,
+                                                         const std::shared_ptr<const PluginConfig>& config) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        const auto it = m_scenes.find(ToLowerAscii(sceneId));
+        if (it == m_scenes.end()) {
+            return nullptr;
+        }
+
+        auto& scene = it->second;
+        if (scene.plan && scene.plan->config == config) {
+            ++m_stats.hits;
+            return scene.plan;
+        }
+
+        scene.plan = std::make_shared<const ScenePlan>(Compile(scene.actions, config));
+        ++m_stats.compiles;
+        return scene.plan;
+    }
+
+    void ScenePlanCache::Clear() {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_scenes.clear();
+        m_stats.scenes = 0;
+    }
+
+    ScenePlanCache::Stats ScenePlanCache::GetStats() const {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_stats;
+    }
+
+}  // namespace KYL
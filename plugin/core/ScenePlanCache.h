@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "PluginConfig.h"
+
+namespace KYL {
+
+    // One action of a scene as the animation framework describes it: actor slots are positions in the
+    // scene's actor list
+    struct SceneAction {
+        std::string name;
+        std::int32_t actorSlot{-1};
+        std::int32_t targetSlot{-1};
+    };
+
+    // Monitors a scene needs, resolved against one config: which actor slot is the probe and which the
+    // target, and the bones, thresholds and volume test of the matching action block
+    struct ScenePlan {
+        struct Entry {
+            std::int32_t probeSlot{-1};
+            std::int32_t targetSlot{-1};
+            ActionType type{ActionType::Vaginal};
+            float threshold{0.0f};
+            float restoreThreshold{0.0f};
+            std::string targetNode;
+            VolumeSpec volume;
+        };
+
+        std::vector<Entry> entries;
+        std::vector<std::string> probeNodes;
+        // Config the plan was resolved against; kept alive so a reload is detected by identity
+        std::shared_ptr<const PluginConfig> config;
+    };
+
+    // Per-scene plans keyed by scene id, so a scene seen before is registered from a table lookup instead
+    // of re-querying its actions. The action lists are kept as described; plans are resolved from them on
+    // first use and again after the config changes. Safe to call from any thread.
+    class ScenePlanCache {
+    public:
+        struct Stats {
+            std::uint64_t hits{0};
+            std::uint64_t compiles{0};
+            std::size_t scenes{0};
+        };
+
+        // Record the actions of a scene (replacing an earlier description)
+        void Define(std::string_view sceneId, std::vector<SceneAction> actions);
+
+        bool Contains(std::string_view sceneId) const;
+
+        // Plan of a defined scene resolved against config, or nullptr if the scene was never defined
+        std::shared_ptr<const ScenePlan> Get(std::string_view sceneId, const std::shared_ptr<const PluginConfig>& config);
+
+        void Clear();
+        Stats GetStats() const;
+
+        // Resolve actions against config; actions no config block lists are left out
+        static ScenePlan Compile(const std::vector<SceneAction>& actions, const std::shared_ptr<const PluginConfig>& config);
+
+    private:
+        struct Scene {
+            std::vector<SceneAction> actions;
+            std::shared_ptr<const ScenePlan> plan;
+        };
+
+        mutable std::mutex m_mutex;
+        // Keys are lower-cased: scene ids reach the plugin as case-insensitive Papyrus strings
+        std::unordered_map<std::string, Scene> m_scenes;
+        Stats m_stats;
+    };
+
+}  // namespace KYL
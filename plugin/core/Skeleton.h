@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "Vector3.h"
+
+namespace KYL {
+
+    // Native actor handle (RE::RefHandle in game, synthetic id in the mock backend)
+    using ActorHandle = std::uint32_t;
+
+    // Opaque node reference. The backend decides what it points to (RE::NiAVObject in game).
+    struct Node;
+    using NodeRef = Node*;
+
+    // Skeleton/transform abstraction the monitoring core talks to.
+    // The SKSE adapter implements it on top of RE::Actor/RE::NiAVObject; the host build uses a mock.
+    class ISkeleton {
+    public:
+        virtual ~ISkeleton() = default;
+
+        // True if the handle currently resolves to a live actor
+        virtual bool IsActorValid(ActorHandle actor) = 0;
+
+        // Display name for log output
+        virtual std::string GetActorName(ActorHandle actor) = 0;
+
+        // Resolve a node by name; returns nullptr if the actor or node is missing
+        virtual NodeRef FindNode(ActorHandle actor, const std::string& nodeName) = 0;
+
+        // Reference counting so cached nodes stay alive like RE::NiPointer
+        virtual void RetainNode(NodeRef node) = 0;
+        virtual void ReleaseNode(NodeRef node) = 0;
+
+        virtual Vector3 GetWorldTranslate(NodeRef node) = 0;
+        // Uniform scale accumulated down to the node (actor scale, genital size scaling); a child's local
+        // translate is multiplied by it to reach world space
+        virtual float GetWorldScale(NodeRef node) = 0;
+        virtual Vector3 GetLocalTranslate(NodeRef node) = 0;
+        virtual void SetLocalTranslate(NodeRef node, const Vector3& translate) = 0;
+
+        // Parent in the scene graph, nullptr for a root
+        virtual NodeRef GetParent(NodeRef node) = 0;
+
+        // Recompute world transforms of the node and its subtree
+        virtual void UpdateWorldData(NodeRef node) = 0;
+    };
+
+    // Owning node reference, the core's equivalent of RE::NiPointer<RE::NiAVObject>
+    class NodePtr {
+    public:
+        NodePtr() = default;
+        NodePtr(ISkeleton* skeleton, NodeRef node) : m_skeleton(skeleton), m_node(node) {
+            if (m_skeleton && m_node) {
+                m_skeleton->RetainNode(m_node);
+            }
+        }
+        ~NodePtr() { reset(); }
+
+        NodePtr(const NodePtr& other) : NodePtr(other.m_skeleton, other.m_node) {}
+        NodePtr& operator=(const NodePtr& other) {
+            if (this != &other) {
+                NodePtr copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        NodePtr(NodePtr&& other) noexcept
+            : m_skeleton(std::exchange(other.m_skeleton, nullptr)), m_node(std::exchange(other.m_node, nullptr)) {}
+        NodePtr& operator=(NodePtr&& other) noexcept {
+            if (this != &other) {
+                reset();
+                m_skeleton = std::exchange(other.m_skeleton, nullptr);
+                m_node = std::exchange(other.m_node, nullptr);
+            }
+            return *this;
+        }
+
+        void reset() {
+            if (m_skeleton && m_node) {
+                m_skeleton->ReleaseNode(m_node);
+            }
+            m_node = nullptr;
+        }
+
+        void swap(NodePtr& other) noexcept {
+            std::swap(m_skeleton, other.m_skeleton);
+            std::swap(m_node, other.m_node);
+        }
+
+        NodeRef get() const { return m_node; }
+        explicit operator bool() const { return m_node != nullptr; }
+
+    private:
+        ISkeleton* m_skeleton{nullptr};
+        NodeRef m_node{nullptr};
+    };
+
+}  // namespace KYL
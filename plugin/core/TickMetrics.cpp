@@ -0,0 +1,84 @@
+#include "TickMetrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include <fmt/format.h>
+
+namespace KYL {
+
+    std::size_t Histogram::BucketOf(std::uint64_t value) {
+        if (value < kSubBuckets) {
+            return static_cast<std::size_t>(value);
+        }
+        // Top kSubBucketBits + 1 bits of the value: the power of two and the step within it
+        const auto exponent = static_cast<std::size_t>(std::bit_width(value)) - 1;
+        const auto step = static_cast<std::size_t>(value >> (exponent - kSubBucketBits)) - kSubBuckets;
+        return (exponent - kSubBucketBits + 1) * kSubBuckets + step;
+    }
+
+    std::uint64_t Histogram::LowerBound(std::size_t bucket) {
+        if (bucket < kSubBuckets) {
+            return bucket;
+        }
+        const std::size_t exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+        const std::uint64_t step = bucket % kSubBuckets;
+        return (kSubBuckets + step) << (exponent - kSubBucketBits);
+    }
+
+    Histogram::Summary Histogram::Summarize() const {
+        Summary summary;
+        summary.count = m_count.load(std::memory_order_relaxed);
+        summary.max = m_max.load(std::memory_order_relaxed);
+        if (summary.count == 0) {
+            return summary;
+        }
+        summary.mean = static_cast<double>(m_sum.load(std::memory_order_relaxed)) / static_cast<double>(summary.count);
+
+        // Each percentile is reported as the middle of its bucket, never above the largest value seen
+        const auto ranks = std::array{0.50, 0.90, 0.99};
+        std::array<std::uint64_t*, 3> outputs{&summary.p50, &summary.p90, &summary.p99};
+        std::size_t next = 0;
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < kBucketCount && next < ranks.size(); ++bucket) {
+            seen += m_buckets[bucket].load(std::memory_order_relaxed);
+            while (next < ranks.size() &&
+                   static_cast<double>(seen) >= std::ceil(ranks[next] * static_cast<double>(summary.count))) {
+                const std::uint64_t lower = LowerBound(bucket);
+                const std::uint64_t upper = bucket + 1 < kBucketCount ? LowerBound(bucket + 1) - 1 : lower;
+                *outputs[next++] = std::min(lower + (upper - lower) / 2, summary.max);
+            }
+        }
+        return summary;
+    }
+
+    void Histogram::Reset() {
+        for (auto& bucket : m_buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        m_count.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    void TickMetrics::Reset() {
+        queueDelayUs.Reset();
+        tickUs.Reset();
+        monitorNs.Reset();
+        boneWrites.Reset();
+        nodeMisses.Reset();
+    }
+
+    std::string TickMetrics::Format() const {
+        const auto part = [](const char* name, const Histogram& histogram, const char* unit) {
+            const auto summary = histogram.Summarize();
+            return fmt::format("{} p50={}{} p99={}{} max={}{}", name, summary.p50, unit, summary.p99, unit, summary.max,
+                               unit);
+        };
+        return fmt::format("{} ticks; {}; {}; {}; {}; {}", tickUs.Summarize().count, part("queue", queueDelayUs, "us"),
+                           part("tick", tickUs, "us"), part("per-monitor", monitorNs, "ns"),
+                           part("writes", boneWrites, ""), part("misses", nodeMisses, ""));
+    }
+
+}  // namespace KYL
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace KYL {
+
+    // Log-linear (HDR-style) histogram of non-negative integers: exact below 16, then 16 buckets per
+    // power of two, so any recorded value is reported within about 6%. Fixed size, never allocates.
+    //
+    // One thread records; any thread may read a snapshot. Counters are relaxed atomics, so a snapshot
+    // taken during a Record can be off by that one sample.
+    class Histogram {
+    public:
+        static constexpr std::size_t kSubBucketBits = 4;
+        static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+        static constexpr std::size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+        struct Summary {
+            std::uint64_t count{0};
+            std::uint64_t p50{0};
+            std::uint64_t p90{0};
+            std::uint64_t p99{0};
+            std::uint64_t max{0};
+            double mean{0.0};
+        };
+
+        void Record(std::uint64_t value) {
+            Bump(m_buckets[BucketOf(value)], 1);
+            Bump(m_count, 1);
+            Bump(m_sum, value);
+            if (value > m_max.load(std::memory_order_relaxed)) {
+                m_max.store(value, std::memory_order_relaxed);
+            }
+        }
+
+        Summary Summarize() const;
+        void Reset();
+
+        static std::size_t BucketOf(std::uint64_t value);
+        // Smallest value that falls into bucket
+        static std::uint64_t LowerBound(std::size_t bucket);
+
+    private:
+        // Single writer: a plain load/store pair is enough and cheaper than a locked add
+        static void Bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        std::array<std::atomic<std::uint64_t>, kBucketCount> m_buckets{};
+        std::atomic<std::uint64_t> m_count{0};
+        std::atomic<std::uint64_t> m_sum{0};
+        std::atomic<std::uint64_t> m_max{0};
+    };
+
+    // Always-on cost figures of the monitor tick, recorded on the ticking thread
+    struct TickMetrics {
+        // Time a posted tick waited in the task queue before it ran, in microseconds (timer mode only)
+        Histogram queueDelayUs;
+        // MonitorEngine::Tick wall time, in microseconds
+        Histogram tickUs;
+        // Tick wall time divided by the monitors evaluated in it, in nanoseconds
+        Histogram monitorNs;
+        Histogram boneWrites;
+        // Bone name searches that found nothing
+        Histogram nodeMisses;
+
+        void Reset();
+
+        // One line: p50/p99/max of every histogram
+        std::string Format() const;
+    };
+
+}  // namespace KYL
@@ -0,0 +1,151 @@
+#include "TickScheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Logger.h"
+#include "Tracer.h"
+
+namespace KYL {
+
+    namespace {
+        // Wake-ups later than this past their deadline are reported as late
+        std::chrono::microseconds LateTolerance(std::chrono::milliseconds interval) {
+            return std::max<std::chrono::microseconds>(interval / 4, std::chrono::milliseconds{2});
+        }
+    }
+
+    TickScheduler::TickScheduler(PostFn post) : m_post(std::move(post)) {}
+
+    TickScheduler::~TickScheduler() { Shutdown(); }
+
+    void TickScheduler::Resume() {
+        std::lock_guard<std::mutex> lk(m_shutdownMutex);
+        if (m_running.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        // Anchor the fixed-rate grid at now so the first tick runs immediately
+        m_nextDeadline = Clock::now();
+        m_rescheduled = true;
+        m_running.store(true, std::memory_order_release);
+
+        if (!m_thread.joinable()) {
+            m_shutdownRequested = false;
+            m_thread = std::thread([this]() { ThreadMain(); });
+        }
+        m_shutdownCV.notify_all();
+    }
+
+    void TickScheduler::Pause() {
+        std::lock_guard<std::mutex> lk(m_shutdownMutex);
+        m_running.store(false, std::memory_order_release);
+        m_rescheduled = true;
+        m_shutdownCV.notify_all();
+    }
+
+    void TickScheduler::Shutdown() {
+        {
+            std::lock_guard<std::mutex> lk(m_shutdownMutex);
+            m_shutdownRequested = true;
+            m_running.store(false, std::memory_order_release);
+            m_shutdownCV.notify_all();
+        }
+
+        if (m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id()) {
+            m_thread.join();
+        }
+        m_tickInFlight.store(false, std::memory_order_release);
+    }
+
+    void TickScheduler::OnTickComplete() { m_tickInFlight.store(false, std::memory_order_release); }
+
+    void TickScheduler::SetInterval(std::chrono::milliseconds interval) {
+        std::lock_guard<std::mutex> lk(m_shutdownMutex);
+        m_interval = interval;
+        if (m_running.load(std::memory_order_relaxed)) {
+            // Re-anchor the grid on the new interval
+            m_nextDeadline = Clock::now() + m_interval;
+            m_rescheduled = true;
+            m_shutdownCV.notify_all();
+        }
+    }
+
+    std::chrono::milliseconds TickScheduler::GetInterval() const {
+        std::lock_guard<std::mutex> lk(m_shutdownMutex);
+        return m_interval;
+    }
+
+    TickScheduler::Stats TickScheduler::GetStats() const {
+        std::lock_guard<std::mutex> lk(m_shutdownMutex);
+        return m_stats;
+    }
+
+    void TickScheduler::ResetStats() {
+        std::lock_guard<std::mutex> lk(m_shutdownMutex);
+        m_stats = {};
+    }
+
+    void TickScheduler::ThreadMain() {
+        Tracer::SetThreadName("TickScheduler");
+        std::unique_lock<std::mutex> lk(m_shutdownMutex);
+
+        while (!m_shutdownRequested) {
+            if (!m_running.load(std::memory_order_relaxed)) {
+                m_shutdownCV.wait(lk, [this]() { return m_shutdownRequested || m_running.load(std::memory_order_relaxed); });
+                continue;
+            }
+
+            m_rescheduled = false;
+            const auto deadline = m_nextDeadline;
+
+            // Interruptible sleep until the next grid point
+            if (m_shutdownCV.wait_until(lk, deadline, [this]() { return m_shutdownRequested || m_rescheduled; })) {
+                continue;
+            }
+
+            const auto now = Clock::now();
+            const auto lateness = std::chrono::duration_cast<std::chrono::microseconds>(now - deadline);
+
+            if (!m_tickInFlight.exchange(true, std::memory_order_acq_rel)) {
+                lk.unlock();
+                const bool queued = [this]() {
+                    KYL_TRACE_SPAN("PostTick");
+                    return m_post();
+                }();
+                lk.lock();
+
+                if (!queued) {
+                    m_tickInFlight.store(false, std::memory_order_release);
+                    m_running.store(false, std::memory_order_release);
+                    continue;
+                }
+                ++m_stats.posted;
+            } else {
+                ++m_stats.skipped;
+                LOG_DEBUG("Tick skipped: previous tick still in flight");
+            }
+
+            if (lateness > LateTolerance(m_interval)) {
+                ++m_stats.late;
+                m_stats.maxLatenessUs = std::max<std::int64_t>(m_stats.maxLatenessUs, lateness.count());
+                LOG_DEBUG("Tick late by {}us (interval {}ms)", lateness.count(), m_interval.count());
+            }
+
+            if (m_rescheduled) {
+                // Paused, resumed or re-timed while posting; the new deadline already applies
+                continue;
+            }
+
+            // Advance on the grid; whole intervals we slept through are skipped, not replayed
+            m_nextDeadline = deadline + m_interval;
+            if (m_nextDeadline <= now) {
+                const auto missed = (now - m_nextDeadline) / m_interval + 1;
+                m_stats.skipped += static_cast<std::uint64_t>(missed);
+                m_nextDeadline += m_interval * missed;
+                LOG_DEBUG("Scheduler fell behind, skipped {} tick(s)", missed);
+            }
+        }
+    }
+
+}  // namespace KYL
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace KYL {
+
+    // Single long-lived timer thread that owns the monitor tick cadence.
+    // Deadlines sit on a fixed-rate grid (start + k * interval) so sleep jitter never accumulates.
+    // Only one tick is in flight at a time: a deadline that arrives while the previous tick is still
+    // queued or running is skipped, and a wake-up past its deadline is counted as late.
+    class TickScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // Hands one tick to the thread that runs it (e.g. SKSE UI task). Returns false if it could not be queued.
+        using PostFn = std::function<bool()>;
+
+        struct Stats {
+            std::uint64_t posted{0};
+            std::uint64_t late{0};
+            std::uint64_t skipped{0};
+            // Worst wake-up lateness seen, in microseconds
+            std::int64_t maxLatenessUs{0};
+        };
+
+        explicit TickScheduler(PostFn post);
+        ~TickScheduler();
+
+        TickScheduler(const TickScheduler&) = delete;
+        TickScheduler& operator=(const TickScheduler&) = delete;
+
+        // Start the cadence (spawning the timer thread on first use); the first tick is posted immediately
+        void Resume();
+
+        // Stop posting ticks; the timer thread stays alive and idles
+        void Pause();
+
+        // Interrupt any wait and join the timer thread
+        void Shutdown();
+
+        // Must be called by the tick once it has finished running
+        void OnTickComplete();
+
+        void SetInterval(std::chrono::milliseconds interval);
+        std::chrono::milliseconds GetInterval() const;
+
+        bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+        Stats GetStats() const;
+        void ResetStats();
+
+    private:
+        void ThreadMain();
+
+        PostFn m_post;
+        std::thread m_thread;
+
+        mutable std::mutex m_shutdownMutex;
+        std::condition_variable m_shutdownCV;
+        bool m_shutdownRequested{false};
+        bool m_rescheduled{false};
+        std::atomic<bool> m_running{false};
+        std::atomic<bool> m_tickInFlight{false};
+
+        std::chrono::milliseconds m_interval{50};
+        Clock::time_point m_nextDeadline{};
+        Stats m_stats;
+    };
+
+}  // namespace KYL
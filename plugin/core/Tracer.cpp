@@ -0,0 +1,154 @@
+#include "Tracer.h"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Logger.h"
+
+namespace KYL {
+
+    namespace {
+        struct TraceEvent {
+            const char* name;
+            std::int64_t startNs;
+            std::int64_t durationNs;
+        };
+
+        // Written only by its thread; Stop reads the first count events once they are published
+        struct ThreadBuffer {
+            std::unique_ptr<TraceEvent[]> events{std::make_unique<TraceEvent[]>(Tracer::kEventsPerThread)};
+            std::atomic<std::size_t> count{0};
+            std::atomic<std::size_t> dropped{0};
+            // Trace the contents belong to; a buffer from an earlier trace is emptied on its next span
+            std::atomic<std::uint64_t> epoch{0};
+            std::atomic<const char*> name{nullptr};
+            std::uint32_t tid{0};
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+            std::atomic<std::uint64_t> epoch{0};
+            std::atomic<Tracer::Clock::rep> startTime{0};
+        };
+
+        Registry& GetRegistry() {
+            // Leaked: threads may still record while static destructors run
+            static auto* registry = new Registry();
+            return *registry;
+        }
+
+        thread_local ThreadBuffer* t_buffer = nullptr;
+        thread_local const char* t_name = nullptr;
+
+        std::int64_t ToNanoseconds(Tracer::Clock::duration duration) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        }
+
+        ThreadBuffer& GetThreadBuffer() {
+            if (!t_buffer) {
+                auto& registry = GetRegistry();
+                std::lock_guard<std::mutex> lk(registry.mutex);
+                auto& buffer = registry.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+                buffer->tid = static_cast<std::uint32_t>(registry.buffers.size());
+                buffer->name.store(t_name, std::memory_order_relaxed);
+                t_buffer = buffer.get();
+            }
+            return *t_buffer;
+        }
+    }
+
+    void Tracer::Start() {
+        auto& registry = GetRegistry();
+        registry.startTime.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        registry.epoch.fetch_add(1, std::memory_order_release);
+        s_enabled.store(true, std::memory_order_release);
+        LOG_INFO("Tracer: started");
+    }
+
+    bool Tracer::Stop(const std::filesystem::path& path, std::size_t* spanCount) {
+        s_enabled.store(false, std::memory_order_release);
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            LOG_ERROR("Tracer: cannot create {}", path.string());
+            return false;
+        }
+
+        auto& registry = GetRegistry();
+        const auto epoch = registry.epoch.load(std::memory_order_acquire);
+        const auto startNs = ToNanoseconds(Clock::duration{registry.startTime.load(std::memory_order_relaxed)});
+
+        std::size_t spans = 0;
+        std::size_t dropped = 0;
+        std::size_t threads = 0;
+        out << "{\"traceEvents\":[\n";
+        {
+            std::lock_guard<std::mutex> lk(registry.mutex);
+            for (const auto& buffer : registry.buffers) {
+                if (buffer->epoch.load(std::memory_order_acquire) != epoch) {
+                    continue;  // recorded nothing in this trace
+                }
+                const auto count = buffer->count.load(std::memory_order_acquire);
+                dropped += buffer->dropped.load(std::memory_order_relaxed);
+
+                const char* name = buffer->name.load(std::memory_order_relaxed);
+                out << (threads++ > 0 ? ",\n" : "")
+                    << fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+                                   buffer->tid, name ? name : fmt::format("thread {}", buffer->tid));
+                for (std::size_t i = 0; i < count; ++i) {
+                    const auto& event = buffer->events[i];
+                    // Trace-event timestamps are microseconds; keep nanosecond precision in the fraction
+                    out << fmt::format(
+                        ",\n{{\"name\":\"{}\",\"cat\":\"kyl\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                        event.name, buffer->tid, static_cast<double>(event.startNs - startNs) / 1000.0,
+                        static_cast<double>(event.durationNs) / 1000.0);
+                }
+                spans += count;
+            }
+        }
+        out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        out.close();
+
+        if (spanCount) {
+            *spanCount = spans;
+        }
+        if (!out) {
+            LOG_ERROR("Tracer: writing {} failed", path.string());
+            return false;
+        }
+        LOG_INFO("Tracer: wrote {} span(s) from {} thread(s) to {} ({} dropped)", spans, threads, path.string(),
+                 dropped);
+        return true;
+    }
+
+    void Tracer::SetThreadName(const char* name) {
+        t_name = name;
+        if (t_buffer) {
+            t_buffer->name.store(name, std::memory_order_relaxed);
+        }
+    }
+
+    void Tracer::Record(const char* name, Clock::time_point start, Clock::time_point end) {
+        auto& buffer = GetThreadBuffer();
+        const auto epoch = GetRegistry().epoch.load(std::memory_order_acquire);
+        if (buffer.epoch.load(std::memory_order_relaxed) != epoch) {
+            buffer.count.store(0, std::memory_order_relaxed);
+            buffer.dropped.store(0, std::memory_order_relaxed);
+            buffer.epoch.store(epoch, std::memory_order_release);
+        }
+
+        const auto index = buffer.count.load(std::memory_order_relaxed);
+        if (index >= kEventsPerThread) {
+            buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.events[index] = {name, ToNanoseconds(start.time_since_epoch()), ToNanoseconds(end - start)};
+        buffer.count.store(index + 1, std::memory_order_release);
+    }
+
+}  // namespace KYL
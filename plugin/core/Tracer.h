@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace KYL {
+
+    // Opt-in span tracer for looking at how registration, tick scheduling, the tick itself and bone writes
+    // interleave across threads. Spans go to a fixed-size buffer owned by the thread that records them
+    // (allocated on its first span after Start), so recording never takes a lock; Stop writes them as
+    // Chrome trace-event JSON, which chrome://tracing and Perfetto open.
+    //
+    // While tracing is off a span costs one relaxed load; built without KYL_TRACING the KYL_TRACE_SPAN
+    // macro compiles to nothing.
+    class Tracer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // Spans kept per thread; later spans are dropped and counted
+        static constexpr std::size_t kEventsPerThread = 1 << 16;
+
+        static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+        // Discard spans from an earlier trace and start recording
+        static void Start();
+
+        // Stop recording and write everything recorded since Start to path; false if the file cannot be
+        // written. Returns the number of spans written through spanCount when it is not null.
+        static bool Stop(const std::filesystem::path& path, std::size_t* spanCount = nullptr);
+
+        // Label for the calling thread in the trace; name must outlive the tracer (a literal)
+        static void SetThreadName(const char* name);
+
+        // Called by TraceSpan; name must be a literal
+        static void Record(const char* name, Clock::time_point start, Clock::time_point end);
+
+    private:
+        static inline std::atomic<bool> s_enabled{false};
+    };
+
+    // Records the enclosing scope as one span while tracing is on
+    class TraceSpan {
+    public:
+        explicit TraceSpan(const char* name) {
+            if (Tracer::IsEnabled()) {
+                m_name = name;
+                m_start = Tracer::Clock::now();
+            }
+        }
+
+        ~TraceSpan() {
+            if (m_name) {
+                Tracer::Record(m_name, m_start, Tracer::Clock::now());
+            }
+        }
+
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+    private:
+        const char* m_name{nullptr};
+        Tracer::Clock::time_point m_start{};
+    };
+
+}  // namespace KYL
+
+#define KYL_TRACE_CONCAT_INNER(a, b) a##b
+#define KYL_TRACE_CONCAT(a, b) KYL_TRACE_CONCAT_INNER(a, b)
+
+#ifdef KYL_TRACING
+#define KYL_TRACE_SPAN(name) const KYL::TraceSpan KYL_TRACE_CONCAT(kylTraceSpan, __LINE__)(name)
+#else
+#define KYL_TRACE_SPAN(name) \
+    do {                     \
+    } while (false)
+#endif
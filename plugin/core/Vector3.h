@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cmath>
+
+namespace KYL {
+
+    // Minimal 3D vector used by the monitoring core. Mirrors the subset of RE::NiPoint3
+    // that the penetration math needs so the core can build without CommonLibSSE.
+    struct Vector3 {
+        float x{0.0f};
+        float y{0.0f};
+        float z{0.0f};
+
+        Vector3 operator+(const Vector3& rhs) const { return {x + rhs.x, y + rhs.y, z + rhs.z}; }
+        Vector3 operator-(const Vector3& rhs) const { return {x - rhs.x, y - rhs.y, z - rhs.z}; }
+        Vector3 operator*(float scalar) const { return {x * scalar, y * scalar, z * scalar}; }
+        Vector3 operator/(float scalar) const { return {x / scalar, y / scalar, z / scalar}; }
+
+        float Dot(const Vector3& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z; }
+        float SqrLength() const { return Dot(*this); }
+        float Length() const { return std::sqrt(SqrLength()); }
+    };
+
+}  // namespace KYL
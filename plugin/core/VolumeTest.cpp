@@ -0,0 +1,70 @@
+#include "VolumeTest.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace KYL {
+
+    namespace {
+        // Segments shorter than this are treated as points
+        constexpr float kDegenerateLengthSq = 1e-8f;
+    }
+
+    BoundingSphere BoundPath(const Vector3& first, const Vector3& last, float pathLength, float radius) {
+        // A point within pathLength of both ends along the path is within half of it of their midpoint
+        const float span = std::max(pathLength, (last - first).Length());
+        return {(first + last) * 0.5f, span * 0.5f + radius};
+    }
+
+    float SphereGap(const BoundingSphere& a, const BoundingSphere& b) {
+        return (a.center - b.center).Length() - a.radius - b.radius;
+    }
+
+    float SegmentDistance(const Vector3& p0, const Vector3& p1, const Vector3& q0, const Vector3& q1) {
+        // Closest points of the two lines, clamped to the segments (Ericson, Real-Time Collision Detection 5.1.9)
+        const Vector3 d1 = p1 - p0;
+        const Vector3 d2 = q1 - q0;
+        const Vector3 r = p0 - q0;
+        const float a = d1.SqrLength();
+        const float e = d2.SqrLength();
+        const float f = d2.Dot(r);
+
+        float s = 0.0f;
+        float t = 0.0f;
+        if (a <= kDegenerateLengthSq && e <= kDegenerateLengthSq) {
+            return r.Length();
+        }
+        if (a <= kDegenerateLengthSq) {
+            t = std::clamp(f / e, 0.0f, 1.0f);
+        } else {
+            const float c = d1.Dot(r);
+            if (e <= kDegenerateLengthSq) {
+                s = std::clamp(-c / a, 0.0f, 1.0f);
+            } else {
+                const float b = d1.Dot(d2);
+                const float denominator = a * e - b * b;
+                // Parallel segments: any s works, start from p0
+                s = denominator > 0.0f ? std::clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+                t = (b * s + f) / e;
+                if (t < 0.0f) {
+                    t = 0.0f;
+                    s = std::clamp(-c / a, 0.0f, 1.0f);
+                } else if (t > 1.0f) {
+                    t = 1.0f;
+                    s = std::clamp((b - c) / a, 0.0f, 1.0f);
+                }
+            }
+        }
+        return ((p0 + d1 * s) - (q0 + d2 * t)).Length();
+    }
+
+    float CapsuleOverlap(std::span<const Vector3> chain, float probeRadius, const Vector3& targetStart,
+                         const Vector3& targetEnd, float targetRadius) {
+        float distance = std::numeric_limits<float>::max();
+        for (std::size_t i = 1; i < chain.size(); ++i) {
+            distance = std::min(distance, SegmentDistance(chain[i - 1], chain[i], targetStart, targetEnd));
+        }
+        return probeRadius + targetRadius - distance;
+    }
+
+}  // namespace KYL
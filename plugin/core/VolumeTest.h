@@ -0,0 +1,44 @@
+#pragma once
+
+#include <span>
+#include <string>
+
+#include "Vector3.h"
+
+namespace KYL {
+
+    // Optional geometric test for a monitor: the probe chain is a capsule of probeRadius around the
+    // segments between its bones, and the target a sphere of targetRadius around the target node, or a
+    // capsule when targetEndNode names a second bone on the target actor. Thresholds then measure how
+    // deep the two volumes overlap (0 = touching, negative = apart) instead of how far the tip is past
+    // the target point. All zero/empty keeps the tip projection test.
+    struct VolumeSpec {
+        float probeRadius{0.0f};
+        float targetRadius{0.0f};
+        std::string targetEndNode;
+
+        bool IsEnabled() const { return probeRadius > 0.0f || targetRadius > 0.0f || !targetEndNode.empty(); }
+        bool operator==(const VolumeSpec&) const = default;
+    };
+
+    struct BoundingSphere {
+        Vector3 center;
+        float radius{0.0f};
+    };
+
+    // Sphere holding every point of any path of at most pathLength from first to last, grown by radius
+    BoundingSphere BoundPath(const Vector3& first, const Vector3& last, float pathLength, float radius);
+
+    // Distance between the surfaces of two spheres; negative when they intersect
+    float SphereGap(const BoundingSphere& a, const BoundingSphere& b);
+
+    // Shortest distance between segments p0-p1 and q0-q1; either may be a single point
+    float SegmentDistance(const Vector3& p0, const Vector3& p1, const Vector3& q0, const Vector3& q1);
+
+    // How deep the capsules around consecutive chain points reach into the target capsule from
+    // targetStart to targetEnd (a sphere when both are equal): the summed radii minus the shortest
+    // distance between the axes. Negative while the volumes are apart. chain needs at least two points.
+    float CapsuleOverlap(std::span<const Vector3> chain, float probeRadius, const Vector3& targetStart,
+                         const Vector3& targetEnd, float targetRadius);
+
+}  // namespace KYL
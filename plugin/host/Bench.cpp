@@ -0,0 +1,681 @@
+// Host benchmark for the monitoring core: runs MonitorEngine::Tick over a synthetic
+// scene with many monitors and reports per-tick cost.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "CalibrationCache.h"
+#include "FramePacer.h"
+#include "MockSkeleton.h"
+#include "MonitorEngine.h"
+#include "PluginConfig.h"
+#include "SampleRecorder.h"
+#include "SyntheticScene.h"
+#include "TickScheduler.h"
+#include "Tracer.h"
+
+namespace {
+    struct BenchOptions {
+        KYL::SyntheticScene::Options scene;
+        std::size_t warmupTicks{100};
+        std::size_t ticks{2000};
+        // When non-zero, drive ticks through TickScheduler at this interval instead of a tight loop
+        std::size_t schedulerIntervalMs{0};
+        // When non-zero, simulate a frame loop and tick on every Nth frame through FramePacer
+        std::size_t frameDivisor{0};
+        // Adaptive evaluation cap in ticks (1 = evaluate every monitor on every tick)
+        std::size_t maxEvalInterval{KYL::kDefaultMaxEvalInterval};
+        // Prediction look-ahead in ticks
+        float lookAheadTicks{0.0f};
+        // Learn each monitor's animation loop and play it back between live checks
+        bool loopLearning{false};
+        // When non-zero, a producer thread re-registers a monitor every N ms while ticks run
+        std::size_t churnIntervalMs{0};
+        // When non-zero, re-submit the scene's monitor set every N measured ticks like a scene change
+        std::size_t sceneChangeTicks{0};
+        // Scene changes stop every monitor and register the set again instead of applying it as a diff
+        bool restartOnSceneChange{false};
+        // When set, seed monitors from and save them to a calibration cache file
+        std::string calibrationPath;
+        // When set, record every evaluation of the run to this sample file
+        std::string recordPath;
+        // When set, write a Chrome trace of the run to this file
+        std::string tracePath;
+        // Fail when a measured tick allocates (requires a KYL_TRACK_ALLOCATIONS build)
+        bool requireZeroAlloc{false};
+        // Fail when a pair's first correction does not land its tip on the shrink threshold
+        bool requireSingleCorrection{false};
+        // Fail when frame-synchronized ticks are more than the divisor apart or not one per divisor frames
+        bool requireFramePacing{false};
+    };
+
+    // Stand-in for the SKSE UI task queue: the timer thread posts, the main thread drains
+    class TaskQueue {
+    public:
+        void Add(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                m_tasks.push_back(std::move(task));
+            }
+            m_cv.notify_one();
+        }
+
+        std::function<void()> Take() {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            m_cv.wait(lk, [this]() { return !m_tasks.empty(); });
+            auto task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            return task;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::deque<std::function<void()>> m_tasks;
+    };
+
+    void PrintUsage(const char* exe) {
+        std::printf(
+            "Usage: %s [--monitors N] [--chain N] [--ticks N] [--warmup N] [--require-zero-alloc]\n"
+            "  --monitors N  number of synthetic probe/target monitors (default 200)\n"
+            "  --chain N     bones per probe chain including base and tip (default 5)\n"
+            "  --targets-per-probe N  monitors sharing each probe chain, each against its own target (default 1)\n"
+            "  --volume R    test the chain and target as volumes of radius R (capsules/sphere) instead of the tip\n"
+            "  --probe-scale S  scale each probe chain by S like actor or genital size scaling and report how each\n"
+            "                pair's first correction lands relative to the threshold\n"
+            "  --ticks N     measured ticks (default 2000)\n"
+            "  --warmup N    unmeasured ticks before measuring (default 100)\n"
+            "  --scheduler-ms N  run ticks through TickScheduler at N ms and report late/skipped ticks\n"
+            "  --frame-divisor N simulate a frame loop and tick on every Nth frame (frame-synchronized mode)\n"
+            "  --max-eval-interval N  evaluate monitors far from their thresholds at most every N ticks (1 = every tick)\n"
+            "  --look-ahead T  extrapolate rising tips T ticks ahead (fractional; 0 = react to the current pose)\n"
+            "  --loop-learning  learn each animation loop and play it back instead of reading the pose\n"
+            "  --churn-ms N  re-register a monitor from another thread every N ms and report submit latency\n"
+            "  --scene-change N  re-apply the monitor set every N ticks and report overshoot\n"
+            "  --restart-scenes  with --scene-change, stop and re-register monitors instead of applying a diff\n"
+            "  --calibration PATH  seed monitors from this calibration cache and save what they learned to it\n"
+            "  --config PATH  take look-ahead and loop learning from a config.json (later flags override)\n"
+            "  --record PATH  record every evaluation to a sample file (convert with KYLSampleCsv)\n"
+            "  --trace PATH  write a Chrome trace-event file of the run (open in chrome://tracing or Perfetto)\n"
+            "  --require-zero-alloc  exit non-zero if any measured tick allocates on the heap\n"
+            "  --require-single-correction  exit non-zero if a first correction misses the threshold (tip test,\n"
+            "                look-ahead 0, one target per probe)\n"
+            "  --require-frame-pacing  with --frame-divisor, exit non-zero if ticks are more than N frames apart or\n"
+            "                the run does not tick exactly once per N frames\n",
+            exe);
+    }
+
+    // Loads a config.json the way the plugin does and adopts its general settings
+    bool ApplyConfigFile(const char* path, BenchOptions& options) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::fprintf(stderr, "Cannot read %s\n", path);
+            return false;
+        }
+        const std::string text{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        std::string error;
+        const auto config = KYL::PluginConfig::Parse(text, error);
+        if (!config) {
+            std::fprintf(stderr, "%s: %s\n", path, error.c_str());
+            return false;
+        }
+
+        options.lookAheadTicks = config->general.lookAheadTicks;
+        options.loopLearning = config->general.loopLearning;
+        std::printf("config: %zu penis bone(s), look-ahead %.2f, loop learning %s\n", config->penisBones.size(),
+                    config->general.lookAheadTicks, config->general.loopLearning ? "on" : "off");
+        for (std::size_t i = 0; i < KYL::kActionTypeCount; ++i) {
+            const auto type = static_cast<KYL::ActionType>(i);
+            const auto& action = config->GetAction(type);
+            std::printf("config: %-7s shrink %.2f restore %.2f bone \"%s\" (%zu OStim action(s))\n",
+                        KYL::GetActionTypeName(type).data(), action.threshold, action.restoreThreshold,
+                        action.bone.c_str(), action.ostimActions.size());
+            if (action.volume.IsEnabled()) {
+                std::printf("config: %-7s volume probe radius %.2f, target radius %.2f%s%s\n",
+                            KYL::GetActionTypeName(type).data(), action.volume.probeRadius,
+                            action.volume.targetRadius, action.volume.targetEndNode.empty() ? "" : ", capsule to ",
+                            action.volume.targetEndNode.c_str());
+            }
+        }
+        return true;
+    }
+
+    bool ParseArgs(int argc, char** argv, BenchOptions& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+                return false;
+            }
+            if (std::strcmp(arg, "--require-zero-alloc") == 0) {
+                options.requireZeroAlloc = true;
+                continue;
+            }
+            if (std::strcmp(arg, "--require-single-correction") == 0) {
+                options.requireSingleCorrection = true;
+                continue;
+            }
+            if (std::strcmp(arg, "--require-frame-pacing") == 0) {
+                options.requireFramePacing = true;
+                continue;
+            }
+            if (std::strcmp(arg, "--restart-scenes") == 0) {
+                options.restartOnSceneChange = true;
+                continue;
+            }
+            if (std::strcmp(arg, "--loop-learning") == 0) {
+                options.loopLearning = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "Missing value for %s\n", arg);
+                return false;
+            }
+
+            if (std::strcmp(arg, "--look-ahead") == 0) {
+                options.lookAheadTicks = std::strtof(argv[++i], nullptr);
+                continue;
+            }
+            if (std::strcmp(arg, "--volume") == 0) {
+                options.scene.volumeRadius = std::max(std::strtof(argv[++i], nullptr), 0.0f);
+                continue;
+            }
+            if (std::strcmp(arg, "--probe-scale") == 0) {
+                options.scene.probeScale = std::max(std::strtof(argv[++i], nullptr), 0.01f);
+                continue;
+            }
+            if (std::strcmp(arg, "--calibration") == 0) {
+                options.calibrationPath = argv[++i];
+                options.scene.calibrationScene = "bench";
+                continue;
+            }
+            if (std::strcmp(arg, "--record") == 0) {
+                options.recordPath = argv[++i];
+                continue;
+            }
+            if (std::strcmp(arg, "--trace") == 0) {
+                options.tracePath = argv[++i];
+                continue;
+            }
+            if (std::strcmp(arg, "--config") == 0) {
+                if (!ApplyConfigFile(argv[++i], options)) {
+                    return false;
+                }
+                continue;
+            }
+
+            const auto value = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+            if (std::strcmp(arg, "--monitors") == 0) {
+                options.scene.monitors = value;
+            } else if (std::strcmp(arg, "--chain") == 0) {
+                options.scene.chainLength = value;
+            } else if (std::strcmp(arg, "--targets-per-probe") == 0) {
+                options.scene.targetsPerProbe = value;
+            } else if (std::strcmp(arg, "--ticks") == 0) {
+                options.ticks = value;
+            } else if (std::strcmp(arg, "--warmup") == 0) {
+                options.warmupTicks = value;
+            } else if (std::strcmp(arg, "--scheduler-ms") == 0) {
+                options.schedulerIntervalMs = value;
+            } else if (std::strcmp(arg, "--frame-divisor") == 0) {
+                options.frameDivisor = value;
+            } else if (std::strcmp(arg, "--max-eval-interval") == 0) {
+                options.maxEvalInterval = value;
+            } else if (std::strcmp(arg, "--scene-change") == 0) {
+                options.sceneChangeTicks = value;
+            } else if (std::strcmp(arg, "--churn-ms") == 0) {
+                options.churnIntervalMs = value;
+            } else {
+                std::fprintf(stderr, "Unknown option %s\n", arg);
+                return false;
+            }
+        }
+        return options.ticks > 0;
+    }
+
+    double Percentile(std::vector<double>& samples, double fraction) {
+        if (samples.empty()) {
+            return 0.0;
+        }
+        const auto idx = static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(idx), samples.end());
+        return samples[idx];
+    }
+
+    // Papyrus stand-in: keeps updating existing monitors from another thread while the tick runs
+    class ChurnProducer {
+    public:
+        ChurnProducer(KYL::MonitorEngine& engine, const std::vector<KYL::MonitorSpec>& specs, std::size_t intervalMs)
+            : m_engine(engine), m_specs(specs), m_interval(intervalMs) {
+            if (m_interval.count() > 0 && !m_specs.empty()) {
+                m_thread = std::thread([this]() { Run(); });
+            }
+        }
+
+        ~ChurnProducer() { Stop(); }
+
+        void Stop() {
+            m_stop.store(true);
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+        }
+
+        void Report() const {
+            if (m_submits == 0) {
+                return;
+            }
+            std::printf("churn: %zu submit(s), mean=%.2fus max=%.2fus\n", m_submits,
+                        m_totalMicros / static_cast<double>(m_submits), m_maxMicros);
+        }
+
+    private:
+        void Run() {
+            while (!m_stop.load()) {
+                auto spec = m_specs[m_submits % m_specs.size()];
+
+                const auto start = std::chrono::steady_clock::now();
+                m_engine.AddMonitor(std::move(spec));
+                const double micros =
+                    std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+                m_totalMicros += micros;
+                m_maxMicros = std::max(m_maxMicros, micros);
+                ++m_submits;
+                std::this_thread::sleep_for(m_interval);
+            }
+        }
+
+        KYL::MonitorEngine& m_engine;
+        const std::vector<KYL::MonitorSpec>& m_specs;
+        std::chrono::milliseconds m_interval;
+        std::atomic<bool> m_stop{false};
+        std::thread m_thread;
+        std::size_t m_submits{0};
+        double m_totalMicros{0.0};
+        double m_maxMicros{0.0};
+    };
+
+    // Attaches the calibration cache for the run; on exit saves what the monitors learned and reports
+    class CalibrationSession {
+    public:
+        CalibrationSession(const BenchOptions& options, KYL::MonitorEngine& engine) : m_engine(engine) {
+            if (!options.calibrationPath.empty() && m_cache.Open(options.calibrationPath)) {
+                m_engine.SetCalibrationCache(&m_cache);
+            }
+        }
+
+        ~CalibrationSession() {
+            if (!m_cache.IsOpen()) {
+                return;
+            }
+            m_engine.Clear();
+            m_engine.SetCalibrationCache(nullptr);
+            m_cache.Close();
+
+            const auto stats = m_cache.GetStats();
+            std::printf("calibration: %llu seeded, %llu new, %llu saved, %zu entries\n",
+                        static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+                        static_cast<unsigned long long>(stats.stored), stats.entries);
+        }
+
+        CalibrationSession(const CalibrationSession&) = delete;
+        CalibrationSession& operator=(const CalibrationSession&) = delete;
+
+    private:
+        KYL::MonitorEngine& m_engine;
+        KYL::CalibrationCache m_cache;
+    };
+
+    // Records the run to a sample file; on exit writes what is buffered and reports
+    class RecordingSession {
+    public:
+        RecordingSession(const BenchOptions& options, KYL::MonitorEngine& engine) : m_engine(engine) {
+            if (!options.recordPath.empty() && m_recorder.Start(options.recordPath)) {
+                m_engine.SetSampleRecorder(&m_recorder);
+            }
+        }
+
+        ~RecordingSession() {
+            if (!m_recorder.IsRecording()) {
+                return;
+            }
+            m_engine.SetSampleRecorder(nullptr);
+            m_recorder.Stop();
+
+            const auto stats = m_recorder.GetStats();
+            std::printf("recording: %llu sample(s) written, %llu dropped\n",
+                        static_cast<unsigned long long>(stats.written), static_cast<unsigned long long>(stats.dropped));
+        }
+
+        RecordingSession(const RecordingSession&) = delete;
+        RecordingSession& operator=(const RecordingSession&) = delete;
+
+    private:
+        KYL::MonitorEngine& m_engine;
+        KYL::SampleRecorder m_recorder;
+    };
+
+    // Traces the run from registration on; on exit writes the trace file
+    class TraceSession {
+    public:
+        explicit TraceSession(const BenchOptions& options) : m_path(options.tracePath) {
+            if (!m_path.empty()) {
+                KYL::Tracer::SetThreadName("Main");
+                KYL::Tracer::Start();
+            }
+        }
+
+        ~TraceSession() {
+            if (m_path.empty()) {
+                return;
+            }
+            std::size_t spans = 0;
+            if (KYL::Tracer::Stop(m_path, &spans)) {
+                std::printf("trace: %zu span(s) written to %s\n", spans, m_path.c_str());
+            }
+        }
+
+        TraceSession(const TraceSession&) = delete;
+        TraceSession& operator=(const TraceSession&) = delete;
+
+    private:
+        std::string m_path;
+    };
+
+    // Follows each pair until its tip first crosses the shrink threshold and the engine answers: the closed-form
+    // pullback should put the tip back on the threshold on that same tick, whatever the chain's scale. Positive
+    // residuals are tips left past the threshold, negative ones chains pulled back too far.
+    class CorrectionCheck {
+    public:
+        static constexpr float kTolerance = 0.01f;
+
+        CorrectionCheck(const BenchOptions& options, const KYL::SyntheticScene& scene)
+            : m_scene(scene), m_enabled(options.scene.probeScale != 1.0f || options.requireSingleCorrection) {
+            if (m_enabled) {
+                m_before.resize(scene.GetPairCount());
+                m_residuals.assign(scene.GetPairCount(), std::nanf(""));
+            }
+        }
+
+        void BeforeTick() {
+            for (std::size_t i = 0; m_enabled && i < m_residuals.size(); ++i) {
+                if (std::isnan(m_residuals[i])) {
+                    m_before[i] = m_scene.MeasureBeyondThreshold(i);
+                }
+            }
+        }
+
+        void AfterTick() {
+            for (std::size_t i = 0; m_enabled && i < m_residuals.size(); ++i) {
+                if (!std::isnan(m_residuals[i]) || m_before[i] <= 0.0f) {
+                    continue;
+                }
+                // A tip that did not move was not evaluated on this tick; wait for the tick that moves it
+                if (const float after = m_scene.MeasureBeyondThreshold(i); after != m_before[i]) {
+                    m_residuals[i] = after;
+                }
+            }
+        }
+
+        // Returns false when a corrected pair missed the threshold
+        bool Report(float probeScale) const {
+            if (!m_enabled) {
+                return true;
+            }
+            std::size_t corrected = 0;
+            std::size_t under = 0;
+            std::size_t over = 0;
+            float worst = 0.0f;
+            for (const float residual : m_residuals) {
+                if (std::isnan(residual)) {
+                    continue;
+                }
+                ++corrected;
+                under += residual > kTolerance ? 1 : 0;
+                over += residual < -kTolerance ? 1 : 0;
+                worst = std::abs(residual) > std::abs(worst) ? residual : worst;
+            }
+            std::printf("first correction (probe scale %.2f): %zu of %zu pair(s), %zu left past the threshold, %zu "
+                        "pulled back too far, worst residual %.4f\n",
+                        probeScale, corrected, m_residuals.size(), under, over, worst);
+            return corrected > 0 && under == 0 && over == 0;
+        }
+
+    private:
+        const KYL::SyntheticScene& m_scene;
+        bool m_enabled{false};
+        std::vector<float> m_before;
+        std::vector<float> m_residuals;
+    };
+
+    int RunScheduled(const BenchOptions& options, KYL::SyntheticScene& scene, KYL::MonitorEngine& engine) {
+        TaskQueue queue;
+        std::size_t frame = 0;
+        bool done = false;
+
+        // Like the plugin, stamp each post so the tick can record how long it sat in the queue
+        std::atomic<std::chrono::steady_clock::rep> postedAt{0};
+        KYL::TickScheduler scheduler([&queue, &postedAt]() {
+            postedAt.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+            queue.Add({});
+            return true;
+        });
+        scheduler.SetInterval(std::chrono::milliseconds{options.schedulerIntervalMs});
+
+        const auto start = std::chrono::steady_clock::now();
+        scheduler.Resume();
+        while (!done) {
+            queue.Take();
+            const std::chrono::steady_clock::duration delay{std::chrono::steady_clock::now().time_since_epoch().count() -
+                                                            postedAt.load(std::memory_order_relaxed)};
+            engine.GetMetrics().queueDelayUs.Record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(delay).count()));
+            scene.Animate(frame);
+            engine.Tick();
+            scheduler.OnTickComplete();
+            done = ++frame >= options.ticks;
+        }
+        scheduler.Shutdown();
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        const auto stats = scheduler.GetStats();
+        const double expected = static_cast<double>(options.schedulerIntervalMs * (options.ticks - 1));
+        std::printf("scheduler interval=%zums ticks=%zu elapsed=%.1fms (ideal %.1fms, drift %.2f%%)\n",
+                    options.schedulerIntervalMs, options.ticks, elapsed.count(), expected,
+                    expected > 0.0 ? (elapsed.count() - expected) * 100.0 / expected : 0.0);
+        std::printf("posted=%llu late=%llu skipped=%llu worst lateness=%lldus\n",
+                    static_cast<unsigned long long>(stats.posted), static_cast<unsigned long long>(stats.late),
+                    static_cast<unsigned long long>(stats.skipped), static_cast<long long>(stats.maxLatenessUs));
+        std::printf("engine metrics: %s\n", engine.GetMetrics().Format().c_str());
+        return 0;
+    }
+
+    int RunFrameSynchronized(const BenchOptions& options, KYL::SyntheticScene& scene, KYL::MonitorEngine& engine) {
+        // Simulated frame source: every frame animates the pose, then the pacer decides whether the
+        // monitor pass runs on it, exactly like the main-thread update hook in game
+        KYL::FramePacer pacer;
+        pacer.SetDivisor(static_cast<std::uint32_t>(options.frameDivisor));
+        pacer.Restart();
+
+        const std::size_t frames = options.ticks * options.frameDivisor;
+        double tickMicros = 0.0;
+        double overshoot = 0.0;
+        std::size_t longestGap = 0;
+        std::size_t lastTickFrame = 0;
+
+        for (std::size_t frame = 0; frame < frames; ++frame) {
+            scene.Animate(frame);
+            if (!pacer.OnFrame()) {
+                // The rendered pose of frames between ticks keeps the last correction
+                overshoot += scene.MeasureOvershoot();
+                continue;
+            }
+
+            if (pacer.GetTickCount() > 1) {
+                longestGap = std::max(longestGap, frame - lastTickFrame);
+            }
+            lastTickFrame = frame;
+
+            const auto start = std::chrono::steady_clock::now();
+            engine.Tick();
+            tickMicros += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            overshoot += scene.MeasureOvershoot();
+        }
+
+        const auto ticks = pacer.GetTickCount();
+        std::printf("frame divisor=%zu frames=%llu ticks=%llu longest gap=%zu frame(s)\n", options.frameDivisor,
+                    static_cast<unsigned long long>(pacer.GetFrameCount()), static_cast<unsigned long long>(ticks),
+                    longestGap);
+        std::printf("tick mean=%.2fus\n", ticks > 0 ? tickMicros / static_cast<double>(ticks) : 0.0);
+        // Mean depth tips spend past the shrink threshold per rendered frame and monitor
+        const double samples = static_cast<double>(frames * std::max<std::size_t>(options.scene.monitors, 1));
+        std::printf("overshoot mean=%.4f per frame and monitor (look-ahead %.2f ticks)\n", overshoot / samples,
+                    options.lookAheadTicks);
+
+        const std::size_t expectedTicks = frames / options.frameDivisor;
+        if (options.requireFramePacing && (longestGap > options.frameDivisor || ticks != expectedTicks)) {
+            std::fprintf(stderr, "Frame pacing broken: expected %zu tick(s) at most %zu frame(s) apart\n",
+                         expectedTicks, options.frameDivisor);
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    KYL::MockSkeleton skeleton;
+    KYL::SyntheticScene scene(skeleton, options.scene);
+    KYL::MonitorEngine engine(skeleton);
+    engine.SetMaxEvalInterval(static_cast<std::uint32_t>(options.maxEvalInterval));
+    engine.SetLookAheadTicks(options.lookAheadTicks);
+    engine.SetLoopLearning(options.loopLearning);
+    const CalibrationSession calibration(options, engine);
+    const RecordingSession recording(options, engine);
+    const TraceSession trace(options);
+    scene.RegisterMonitors(engine);
+
+    if (options.schedulerIntervalMs > 0) {
+        return RunScheduled(options, scene, engine);
+    }
+    if (options.frameDivisor > 0) {
+        return RunFrameSynchronized(options, scene, engine);
+    }
+
+    CorrectionCheck correctionCheck(options, scene);
+    std::size_t frame = 0;
+    for (std::size_t i = 0; i < options.warmupTicks; ++i, ++frame) {
+        scene.Animate(frame);
+        correctionCheck.BeforeTick();
+        engine.Tick();
+        correctionCheck.AfterTick();
+    }
+
+    skeleton.ResetCounters();
+    engine.ResetAllocationStats();
+    engine.ResetEvaluationStats();
+    engine.GetMetrics().Reset();
+    std::vector<double> tickMicros;
+    tickMicros.reserve(options.ticks);
+
+    ChurnProducer churn(engine, scene.GetSpecs(), options.churnIntervalMs);
+    double overshoot = 0.0;
+
+    for (std::size_t i = 0; i < options.ticks; ++i, ++frame) {
+        scene.Animate(frame);
+        if (options.sceneChangeTicks > 0 && i > 0 && i % options.sceneChangeTicks == 0) {
+            // Same pairs again, as when a scene moves to its next stage with the same actions
+            if (options.restartOnSceneChange) {
+                engine.RemoveMonitors({});
+                scene.RegisterMonitors(engine);
+            } else {
+                engine.ApplyMonitorSet({}, scene.GetSpecs());
+            }
+        }
+
+        correctionCheck.BeforeTick();
+        const auto start = std::chrono::steady_clock::now();
+        engine.Tick();
+        const auto end = std::chrono::steady_clock::now();
+        correctionCheck.AfterTick();
+
+        tickMicros.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        if (options.sceneChangeTicks > 0) {
+            overshoot += scene.MeasureOvershoot();
+        }
+    }
+    churn.Stop();
+
+    double total = 0.0;
+    for (const double sample : tickMicros) {
+        total += sample;
+    }
+
+    const double ticks = static_cast<double>(options.ticks);
+    const double mean = total / ticks;
+    const double perMonitorNs = options.scene.monitors > 0 ? mean * 1000.0 / static_cast<double>(options.scene.monitors) : 0.0;
+    const auto& counters = skeleton.GetCounters();
+
+    std::printf("monitors=%zu chain=%zu ticks=%zu\n", options.scene.monitors, options.scene.chainLength, options.ticks);
+    std::printf("tick mean=%.2fus p50=%.2fus p99=%.2fus max=%.2fus per-monitor=%.1fns\n", mean,
+                Percentile(tickMicros, 0.50), Percentile(tickMicros, 0.99),
+                *std::max_element(tickMicros.begin(), tickMicros.end()), perMonitorNs);
+    std::printf("per tick: findNode=%.1f (misses %.1f) worldReads=%.1f localWrites=%.1f worldUpdates=%.1f "
+                "nodesUpdated=%.1f\n",
+                static_cast<double>(counters.findNodeCalls) / ticks, static_cast<double>(counters.findNodeMisses) / ticks,
+                static_cast<double>(counters.worldReads) / ticks, static_cast<double>(counters.localWrites) / ticks, static_cast<double>(counters.worldUpdates) / ticks,
+                static_cast<double>(counters.nodesUpdated) / ticks);
+    const auto evaluation = engine.GetEvaluationStats();
+    std::printf("evaluated per tick=%.1f (deferred %.1f, played back %.1f, rejected %.1f, max interval %zu)\n",
+                static_cast<double>(evaluation.evaluated) / ticks, static_cast<double>(evaluation.deferred) / ticks,
+                static_cast<double>(evaluation.playedBack) / ticks, static_cast<double>(evaluation.rejected) / ticks,
+                options.maxEvalInterval);
+    std::printf("engine metrics: %s\n", engine.GetMetrics().Format().c_str());
+    churn.Report();
+    if (options.sceneChangeTicks > 0) {
+        std::printf("scene change every %zu tick(s) (%s): overshoot mean=%.4f per tick and monitor\n",
+                    options.sceneChangeTicks, options.restartOnSceneChange ? "restart" : "diff",
+                    overshoot / (ticks * static_cast<double>(std::max<std::size_t>(options.scene.monitors, 1))));
+    }
+    if (!correctionCheck.Report(options.scene.probeScale) && options.requireSingleCorrection) {
+        std::fprintf(stderr, "A first correction missed the shrink threshold\n");
+        return 1;
+    }
+
+    if (!KYL::AllocationScope::IsEnabled()) {
+        std::printf("allocations: not tracked (build with KYL_TRACK_ALLOCATIONS)\n");
+        return options.requireZeroAlloc ? 1 : 0;
+    }
+
+    const auto allocations = engine.GetAllocationStats();
+    std::printf("allocations: %llu in %llu of %llu steady-state tick(s)\n",
+                static_cast<unsigned long long>(allocations.allocations),
+                static_cast<unsigned long long>(allocations.ticksWithAllocations),
+                static_cast<unsigned long long>(allocations.steadyTicks));
+    if (options.requireZeroAlloc && allocations.allocations > 0) {
+        std::fprintf(stderr, "Steady-state ticks allocated on the heap\n");
+        return 1;
+    }
+    return 0;
+}
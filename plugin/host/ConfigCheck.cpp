@@ -0,0 +1,64 @@
+// Parses config.json files the way the plugin loads them and prints what was read. Exits non-zero when
+// a file does not parse, or with --expect-invalid when one does (the malformed-input ctest entries).
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "PluginConfig.h"
+
+namespace {
+    void Print(const char* path, const KYL::PluginConfig& config) {
+        const auto& general = config.general;
+        std::printf("%s: ok intervalMs=%d frameDivisor=%d lookAheadTicks=%g loopLearning=%s penisBones=%zu\n",
+                    path, general.intervalMs, general.frameDivisor, static_cast<double>(general.lookAheadTicks),
+                    general.loopLearning ? "true" : "false", config.penisBones.size());
+        for (std::size_t i = 0; i < KYL::kActionTypeCount; ++i) {
+            const auto type = static_cast<KYL::ActionType>(i);
+            const auto& action = config.GetAction(type);
+            std::printf("  %s: threshold=%g restoreThreshold=%g bone=\"%s\" ostimActions=%zu sexlabTags=%zu\n",
+                        KYL::GetActionTypeName(type).data(), static_cast<double>(action.threshold),
+                        static_cast<double>(action.restoreThreshold), action.bone.c_str(),
+                        action.ostimActions.size(), action.sexlabTags.size());
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bool expectInvalid = false;
+    int first = 1;
+    if (first < argc && std::strcmp(argv[first], "--expect-invalid") == 0) {
+        expectInvalid = true;
+        ++first;
+    }
+    if (first >= argc) {
+        std::fprintf(stderr, "Usage: %s [--expect-invalid] CONFIG.json...\n", argv[0]);
+        return 1;
+    }
+
+    bool passed = true;
+    for (int i = first; i < argc; ++i) {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file) {
+            std::fprintf(stderr, "%s: cannot read\n", argv[i]);
+            passed = false;
+            continue;
+        }
+        const std::string text{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        std::string error;
+        const auto config = KYL::PluginConfig::Parse(text, error);
+        if (config) {
+            Print(argv[i], *config);
+        } else {
+            std::printf("%s: invalid (%s)\n", argv[i], error.c_str());
+        }
+        if (config.has_value() == expectInvalid) {
+            std::fprintf(stderr, "%s: expected the file to be %s\n", argv[i], expectInvalid ? "rejected" : "accepted");
+            passed = false;
+        }
+    }
+    return passed ? 0 : 1;
+}
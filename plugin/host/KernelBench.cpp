@@ -0,0 +1,154 @@
+// Microbenchmark and equivalence check for the batched penetration kernel.
+// Every implementation the CPU supports is first compared lane by lane against the original
+// per-monitor Vector3 math, then timed on the same gathered batch. --check-only skips the timing
+// (the ctest entry).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "PenetrationKernel.h"
+#include "Vector3.h"
+
+namespace {
+    struct BatchData {
+        std::vector<float> baseX, baseY, baseZ, tipX, tipY, tipZ, targetX, targetY, targetZ;
+        std::vector<float> directionX, directionY, directionZ, probeLength, tipPenetration;
+
+        explicit BatchData(std::size_t count) {
+            for (auto* array : {&baseX, &baseY, &baseZ, &tipX, &tipY, &tipZ, &targetX, &targetY, &targetZ,
+                                &directionX, &directionY, &directionZ, &probeLength, &tipPenetration}) {
+                array->resize(count);
+            }
+        }
+
+        KYL::PenetrationBatch Batch() {
+            KYL::PenetrationBatch batch;
+            batch.count = baseX.size();
+            batch.baseX = baseX.data();
+            batch.baseY = baseY.data();
+            batch.baseZ = baseZ.data();
+            batch.tipX = tipX.data();
+            batch.tipY = tipY.data();
+            batch.tipZ = tipZ.data();
+            batch.targetX = targetX.data();
+            batch.targetY = targetY.data();
+            batch.targetZ = targetZ.data();
+            batch.directionX = directionX.data();
+            batch.directionY = directionY.data();
+            batch.directionZ = directionZ.data();
+            batch.probeLength = probeLength.data();
+            batch.tipPenetration = tipPenetration.data();
+            return batch;
+        }
+    };
+
+    // Positions around a skeleton-sized volume with probe chains of realistic length
+    void FillRandom(BatchData& data, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> world(-2000.0f, 2000.0f);
+        std::uniform_real_distribution<float> local(-15.0f, 15.0f);
+        for (std::size_t i = 0; i < data.baseX.size(); ++i) {
+            data.baseX[i] = world(rng);
+            data.baseY[i] = world(rng);
+            data.baseZ[i] = world(rng);
+            data.tipX[i] = data.baseX[i] + local(rng);
+            data.tipY[i] = data.baseY[i] + local(rng);
+            data.tipZ[i] = data.baseZ[i] + local(rng);
+            data.targetX[i] = data.tipX[i] + local(rng);
+            data.targetY[i] = data.tipY[i] + local(rng);
+            data.targetZ[i] = data.tipZ[i] + local(rng);
+        }
+    }
+
+    float RelativeError(float actual, float expected) {
+        return std::abs(actual - expected) / std::max(1.0f, std::abs(expected));
+    }
+
+    // Compare one kernel run against the per-monitor math the engine used before batching
+    bool CheckEquivalence(BatchData& data, KYL::KernelIsa isa, float& worstError) {
+        KYL::ComputePenetration(data.Batch(), isa);
+
+        worstError = 0.0f;
+        for (std::size_t i = 0; i < data.baseX.size(); ++i) {
+            const KYL::Vector3 base{data.baseX[i], data.baseY[i], data.baseZ[i]};
+            const KYL::Vector3 tip{data.tipX[i], data.tipY[i], data.tipZ[i]};
+            const KYL::Vector3 target{data.targetX[i], data.targetY[i], data.targetZ[i]};
+
+            KYL::Vector3 probeDirection = tip - base;
+            const float probeLength = probeDirection.Length();
+            if (probeLength < 0.001f) {
+                continue;  // engine skips degenerate probes
+            }
+            probeDirection = probeDirection / probeLength;
+            const float tipPenetration = (tip - target).Dot(probeDirection);
+
+            worstError = std::max({worstError, RelativeError(data.probeLength[i], probeLength),
+                                   RelativeError(data.tipPenetration[i], tipPenetration),
+                                   RelativeError(data.directionX[i], probeDirection.x),
+                                   RelativeError(data.directionY[i], probeDirection.y),
+                                   RelativeError(data.directionZ[i], probeDirection.z)});
+        }
+        return worstError <= 1e-5f;
+    }
+
+    double TimeKernel(BatchData& data, KYL::KernelIsa isa, std::size_t iterations) {
+        const auto batch = data.Batch();
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            KYL::ComputePenetration(batch, isa);
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        return elapsed.count() / static_cast<double>(iterations * batch.count);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = 1021;  // deliberately not a multiple of the SIMD width to exercise the tails
+    std::size_t iterations = 20000;
+    bool checkOnly = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--check-only") == 0) {
+            checkOnly = true;
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--monitors") == 0) {
+            count = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--iterations") == 0) {
+            iterations = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+    }
+
+    BatchData data(count);
+    FillRandom(data, 1234u);
+
+    const auto best = KYL::DetectKernelIsa();
+    std::printf("monitors=%zu iterations=%zu runtime selection=%s\n", count, iterations, KYL::GetKernelIsaName(best));
+
+    std::vector<KYL::KernelIsa> isas{KYL::KernelIsa::Scalar};
+    if (best == KYL::KernelIsa::SSE || best == KYL::KernelIsa::AVX2) {
+        isas.push_back(KYL::KernelIsa::SSE);
+    }
+    if (best == KYL::KernelIsa::AVX2) {
+        isas.push_back(KYL::KernelIsa::AVX2);
+    }
+
+    bool allEquivalent = true;
+    for (const auto isa : isas) {
+        float worstError = 0.0f;
+        const bool equivalent = CheckEquivalence(data, isa, worstError);
+        allEquivalent = allEquivalent && equivalent;
+
+        std::printf("%-6s %s (worst relative error %.3g)", KYL::GetKernelIsaName(isa),
+                    equivalent ? "matches scalar" : "MISMATCH", static_cast<double>(worstError));
+        if (!checkOnly) {
+            std::printf(" %.3f ns/monitor", TimeKernel(data, isa, iterations));
+        }
+        std::printf("\n");
+    }
+
+    return allEquivalent ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include "MockSkeleton.h"
+
+#include <utility>
+
+namespace KYL {
+
+    ActorHandle MockSkeleton::AddActor(const std::string& name) {
+        const ActorHandle handle = m_nextHandle++;
+        m_actors[handle].name = name;
+        return handle;
+    }
+
+    void MockSkeleton::RemoveActor(ActorHandle actor) {
+        auto it = m_actors.find(actor);
+        if (it == m_actors.end()) {
+            return;
+        }
+
+        for (auto& node : it->second.nodes) {
+            m_detachedNodes.push_back(std::move(node));
+        }
+        m_actors.erase(it);
+    }
+
+    NodeRef MockSkeleton::AddNode(ActorHandle actor, const std::string& nodeName, NodeRef parent,
+                                  const Vector3& bindOffset) {
+        auto it = m_actors.find(actor);
+        if (it == m_actors.end()) {
+            return nullptr;
+        }
+
+        auto node = std::make_unique<MockNode>();
+        node->name = nodeName;
+        node->parent = ToMock(parent);
+        node->bindOffset = bindOffset;
+        if (node->parent) {
+            node->parent->children.push_back(node.get());
+        }
+
+        auto* raw = node.get();
+        it->second.byName[nodeName] = raw;
+        it->second.nodes.push_back(std::move(node));
+        UpdateSubtree(raw);
+        return FromMock(raw);
+    }
+
+    void MockSkeleton::SetBindOffset(NodeRef node, const Vector3& bindOffset) { ToMock(node)->bindOffset = bindOffset; }
+
+    void MockSkeleton::SetScale(NodeRef node, float scale) { ToMock(node)->scale = scale; }
+
+    void MockSkeleton::UpdateActor(ActorHandle actor) {
+        auto it = m_actors.find(actor);
+        if (it == m_actors.end()) {
+            return;
+        }
+
+        for (auto& node : it->second.nodes) {
+            if (!node->parent) {
+                UpdateSubtree(node.get());
+            }
+        }
+    }
+
+    bool MockSkeleton::IsActorValid(ActorHandle actor) { return m_actors.contains(actor); }
+
+    std::string MockSkeleton::GetActorName(ActorHandle actor) {
+        auto it = m_actors.find(actor);
+        return it != m_actors.end() ? it->second.name : std::string{"<none>"};
+    }
+
+    NodeRef MockSkeleton::FindNode(ActorHandle actor, const std::string& nodeName) {
+        ++m_counters.findNodeCalls;
+
+        auto it = m_actors.find(actor);
+        if (it != m_actors.end()) {
+            if (auto nodeIt = it->second.byName.find(nodeName); nodeIt != it->second.byName.end()) {
+                return FromMock(nodeIt->second);
+            }
+        }
+
+        ++m_counters.findNodeMisses;
+        return nullptr;
+    }
+
+    void MockSkeleton::RetainNode(NodeRef node) { ++ToMock(node)->refCount; }
+
+    void MockSkeleton::ReleaseNode(NodeRef node) { --ToMock(node)->refCount; }
+
+    Vector3 MockSkeleton::GetWorldTranslate(NodeRef node) {
+        ++m_counters.worldReads;
+        return ToMock(node)->world;
+    }
+
+    float MockSkeleton::GetWorldScale(NodeRef node) {
+        ++m_counters.worldReads;
+        return ToMock(node)->worldScale;
+    }
+
+    Vector3 MockSkeleton::GetLocalTranslate(NodeRef node) { return ToMock(node)->local; }
+
+    void MockSkeleton::SetLocalTranslate(NodeRef node, const Vector3& translate) {
+        ++m_counters.localWrites;
+        ToMock(node)->local = translate;
+        if (m_writeObserver) {
+            m_writeObserver(node, translate);
+        }
+    }
+
+    NodeRef MockSkeleton::GetParent(NodeRef node) { return FromMock(ToMock(node)->parent); }
+
+    void MockSkeleton::UpdateWorldData(NodeRef node) {
+        ++m_counters.worldUpdates;
+        m_counters.nodesUpdated += UpdateSubtree(ToMock(node));
+    }
+
+    std::size_t MockSkeleton::UpdateSubtree(MockNode* node) {
+        const Vector3 parentWorld = node->parent ? node->parent->world : Vector3{};
+        const float parentScale = node->parent ? node->parent->worldScale : 1.0f;
+        node->world = parentWorld + (node->bindOffset + node->local) * parentScale;
+        node->worldScale = parentScale * node->scale;
+
+        std::size_t updated = 1;
+        for (auto* child : node->children) {
+            updated += UpdateSubtree(child);
+        }
+        return updated;
+    }
+
+}  // namespace KYL
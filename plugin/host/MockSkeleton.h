@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Skeleton.h"
+
+namespace KYL {
+
+    // In-memory ISkeleton backend for host builds (benchmarks, profiling).
+    // Nodes form a translate-and-scale hierarchy: world = parent world + parent world scale * (bind offset +
+    // local translate). The bind offset stands in for the animated pose; the local translate is what the
+    // engine writes. Scales default to 1 and stand in for actor and genital size scaling.
+    class MockSkeleton final : public ISkeleton {
+    public:
+        struct Counters {
+            std::size_t findNodeCalls{0};
+            std::size_t findNodeMisses{0};
+            std::size_t worldReads{0};
+            std::size_t localWrites{0};
+            std::size_t worldUpdates{0};
+            std::size_t nodesUpdated{0};
+        };
+
+        ActorHandle AddActor(const std::string& name);
+        void RemoveActor(ActorHandle actor);
+
+        // Parent may be nullptr for a root node
+        NodeRef AddNode(ActorHandle actor, const std::string& nodeName, NodeRef parent, const Vector3& bindOffset);
+
+        // Animation input: move a node's bind pose, then recompute the actor's world transforms
+        void SetBindOffset(NodeRef node, const Vector3& bindOffset);
+        // Local scale of a node; applies to its children's translates. Takes effect on the next update.
+        void SetScale(NodeRef node, float scale);
+        void UpdateActor(ActorHandle actor);
+
+        // Called with every local translate the engine writes (replay output); empty by default
+        using WriteObserver = std::function<void(NodeRef node, const Vector3& translate)>;
+        void SetWriteObserver(WriteObserver observer) { m_writeObserver = std::move(observer); }
+
+        const Counters& GetCounters() const { return m_counters; }
+        void ResetCounters() { m_counters = {}; }
+
+        bool IsActorValid(ActorHandle actor) override;
+        std::string GetActorName(ActorHandle actor) override;
+        NodeRef FindNode(ActorHandle actor, const std::string& nodeName) override;
+
+        void RetainNode(NodeRef node) override;
+        void ReleaseNode(NodeRef node) override;
+
+        Vector3 GetWorldTranslate(NodeRef node) override;
+        float GetWorldScale(NodeRef node) override;
+        Vector3 GetLocalTranslate(NodeRef node) override;
+        void SetLocalTranslate(NodeRef node, const Vector3& translate) override;
+        NodeRef GetParent(NodeRef node) override;
+        void UpdateWorldData(NodeRef node) override;
+
+    private:
+        struct MockNode {
+            std::string name;
+            MockNode* parent{nullptr};
+            std::vector<MockNode*> children;
+            Vector3 bindOffset;
+            Vector3 local;
+            Vector3 world;
+            float scale{1.0f};
+            float worldScale{1.0f};
+            int refCount{0};
+        };
+
+        struct MockActor {
+            std::string name;
+            std::vector<std::unique_ptr<MockNode>> nodes;
+            std::unordered_map<std::string, MockNode*> byName;
+        };
+
+        static MockNode* ToMock(NodeRef node) { return reinterpret_cast<MockNode*>(node); }
+        static NodeRef FromMock(MockNode* node) { return reinterpret_cast<NodeRef>(node); }
+
+        // Returns the number of nodes recomputed
+        std::size_t UpdateSubtree(MockNode* node);
+
+        std::unordered_map<ActorHandle, MockActor> m_actors;
+        // Nodes of removed actors stay allocated because the engine may still hold references
+        std::vector<std::unique_ptr<MockNode>> m_detachedNodes;
+        ActorHandle m_nextHandle{0x100000};
+        Counters m_counters;
+        WriteObserver m_writeObserver;
+    };
+
+}  // namespace KYL
@@ -0,0 +1,454 @@
+// Replays a sample recording (SampleRecorder / KYLBench --record / StartSampleRecording) through
+// MonitorEngine on the mock skeleton: the recorded base, tip and target positions of every monitor drive
+// the same hysteresis and offset logic as the plugin's ticks, with no game attached. Reports the bone
+// writes the engine makes, a digest of them for regression checks, and tick timing.
+//
+// Positions are replayed as recorded; the writes are reported but not fed back into the pose, so the
+// same recording and settings always produce the same writes.
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "MockSkeleton.h"
+#include "MonitorEngine.h"
+#include "SampleRecorder.h"
+
+namespace {
+    struct ReplayOptions {
+        std::string recordingPath;
+        // When set, every bone write is written to this CSV
+        std::string writesPath;
+        // Whole-recording passes, each through a fresh engine; later passes must match the first
+        std::size_t repeat{1};
+        std::size_t maxEvalInterval{KYL::kDefaultMaxEvalInterval};
+        float lookAheadTicks{0.0f};
+        bool loopLearning{false};
+        // Exit non-zero unless the writes hash to this value
+        std::optional<std::uint64_t> expectedDigest;
+    };
+
+    // Recorded monitors are told apart by actor pair and registry slot
+    struct MonitorKey {
+        KYL::ActorHandle probe{0};
+        KYL::ActorHandle target{0};
+        std::uint32_t monitor{0};
+
+        auto operator<=>(const MonitorKey&) const = default;
+    };
+
+    struct ReplayMonitor {
+        MonitorKey key;
+        std::size_t chainLength{0};
+    };
+
+    // Samples of one recorded tick
+    struct Frame {
+        std::uint64_t tick{0};
+        std::size_t begin{0};
+        std::size_t end{0};
+    };
+
+    struct BoneWrite {
+        std::uint64_t tick{0};
+        std::uint32_t monitor{0};
+        std::uint32_t bone{0};
+        float y{0.0f};
+    };
+
+    // Chains without a recorded length (older recordings) get the common five-bone probe
+    constexpr std::size_t kDefaultChainLength = 5;
+
+    void PrintUsage(const char* exe) {
+        std::fprintf(
+            stderr,
+            "Usage: %s RECORDING [options]\n"
+            "  --writes PATH  write every bone write as CSV (tick,probe,target,monitor,bone,y)\n"
+            "  --repeat N     replay N times through fresh engines and check every pass matches the first\n"
+            "  --max-eval-interval N  evaluate monitors far from their thresholds at most every N ticks\n"
+            "  --look-ahead T  extrapolate rising tips T ticks ahead\n"
+            "  --loop-learning  learn each animation loop and play it back\n"
+            "  --expect-digest HEX  exit non-zero unless the bone writes hash to HEX\n",
+            exe);
+    }
+
+    bool ParseArgs(int argc, char** argv, ReplayOptions& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+                return false;
+            }
+            if (std::strcmp(arg, "--loop-learning") == 0) {
+                options.loopLearning = true;
+                continue;
+            }
+            if (arg[0] != '-') {
+                options.recordingPath = arg;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "Missing value for %s\n", arg);
+                return false;
+            }
+
+            const char* value = argv[++i];
+            if (std::strcmp(arg, "--writes") == 0) {
+                options.writesPath = value;
+            } else if (std::strcmp(arg, "--repeat") == 0) {
+                options.repeat = std::max<std::size_t>(std::strtoull(value, nullptr, 10), 1);
+            } else if (std::strcmp(arg, "--max-eval-interval") == 0) {
+                options.maxEvalInterval = std::strtoull(value, nullptr, 10);
+            } else if (std::strcmp(arg, "--look-ahead") == 0) {
+                options.lookAheadTicks = std::strtof(value, nullptr);
+            } else if (std::strcmp(arg, "--expect-digest") == 0) {
+                options.expectedDigest = std::strtoull(value, nullptr, 16);
+            } else {
+                std::fprintf(stderr, "Unknown option %s\n", arg);
+                return false;
+            }
+        }
+        return !options.recordingPath.empty();
+    }
+
+    double Percentile(std::vector<double>& samples, double fraction) {
+        if (samples.empty()) {
+            return 0.0;
+        }
+        const auto idx = static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(idx), samples.end());
+        return samples[idx];
+    }
+
+    // FNV-1a over the writes in order; any change in which bone moves when, or by how much, changes it
+    std::uint64_t Digest(const std::vector<BoneWrite>& writes) {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        const auto mix = [&hash](const void* data, std::size_t size) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+            }
+        };
+        for (const auto& write : writes) {
+            mix(&write.tick, sizeof(write.tick));
+            mix(&write.monitor, sizeof(write.monitor));
+            mix(&write.bone, sizeof(write.bone));
+            mix(&write.y, sizeof(write.y));
+        }
+        return hash;
+    }
+
+    // The recording regrouped into monitors and per-tick frames
+    class Recording {
+    public:
+        explicit Recording(std::vector<KYL::TickSample> samples) : m_samples(std::move(samples)) {
+            // The recorder writes in tick order; keep it that way for files stitched together by hand
+            std::stable_sort(m_samples.begin(), m_samples.end(),
+                             [](const auto& a, const auto& b) { return a.tick < b.tick; });
+
+            std::map<MonitorKey, std::uint32_t> index;
+            m_monitorOf.reserve(m_samples.size());
+            for (std::size_t i = 0; i < m_samples.size(); ++i) {
+                const auto& sample = m_samples[i];
+                const MonitorKey key{sample.probeHandle, sample.targetHandle, sample.monitor};
+                const auto [it, added] = index.try_emplace(key, static_cast<std::uint32_t>(m_monitors.size()));
+                if (added) {
+                    m_monitors.push_back({key, 0});
+                }
+                auto& monitor = m_monitors[it->second];
+                monitor.chainLength = std::max<std::size_t>(monitor.chainLength, sample.chainLength);
+                m_monitorOf.push_back(it->second);
+
+                if (m_frames.empty() || m_frames.back().tick != sample.tick) {
+                    m_frames.push_back({sample.tick, i, i});
+                }
+                m_frames.back().end = i + 1;
+            }
+            for (auto& monitor : m_monitors) {
+                if (monitor.chainLength < 3) {
+                    monitor.chainLength = kDefaultChainLength;
+                }
+            }
+            for (std::size_t i = 0; i < m_samples.size(); ++i) {
+                m_middleBoneSamples += m_monitors[m_monitorOf[i]].chainLength - 2;
+            }
+        }
+
+        const std::vector<KYL::TickSample>& GetSamples() const { return m_samples; }
+        const std::vector<ReplayMonitor>& GetMonitors() const { return m_monitors; }
+        const std::vector<Frame>& GetFrames() const { return m_frames; }
+        std::uint32_t MonitorOf(std::size_t sample) const { return m_monitorOf[sample]; }
+        // Middle bones summed over all samples: the writes if every recorded evaluation moved every bone
+        std::size_t GetMiddleBoneSamples() const { return m_middleBoneSamples; }
+
+    private:
+        std::vector<KYL::TickSample> m_samples;
+        std::vector<ReplayMonitor> m_monitors;
+        std::vector<std::uint32_t> m_monitorOf;
+        std::vector<Frame> m_frames;
+        std::size_t m_middleBoneSamples{0};
+    };
+
+    struct PassResult {
+        std::vector<BoneWrite> writes;
+        std::vector<double> tickMicros;
+        KYL::EvaluationStats evaluation;
+        KYL::TickAllocationStats allocations;
+    };
+
+    // One pass over the recording through a fresh skeleton and engine
+    class ReplayPass {
+    public:
+        ReplayPass(const Recording& recording, const ReplayOptions& options)
+            : m_recording(recording), m_engine(m_skeleton) {
+            m_engine.SetMaxEvalInterval(static_cast<std::uint32_t>(options.maxEvalInterval));
+            m_engine.SetLookAheadTicks(options.lookAheadTicks);
+            m_engine.SetLoopLearning(options.loopLearning);
+            BuildScene();
+
+            m_skeleton.SetWriteObserver([this](KYL::NodeRef node, const KYL::Vector3& translate) {
+                if (const auto it = m_boneOf.find(node); it != m_boneOf.end()) {
+                    m_result.writes.push_back({m_tick, it->second.first, it->second.second, translate.y});
+                }
+            });
+        }
+
+        PassResult Run() {
+            const auto& frames = m_recording.GetFrames();
+            if (frames.empty()) {
+                return {};
+            }
+            m_result.tickMicros.reserve(frames.back().tick - frames.front().tick + 1);
+            // Keeps collecting the writes out of the engine's allocation count
+            m_result.writes.reserve(m_recording.GetMiddleBoneSamples());
+
+            // Every tick of the recorded range runs, including ticks where each monitor was deferred
+            auto frame = frames.begin();
+            for (m_tick = frames.front().tick; m_tick <= frames.back().tick; ++m_tick) {
+                if (frame != frames.end() && frame->tick == m_tick) {
+                    ApplyFrame(*frame++);
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                m_engine.Tick();
+                const auto end = std::chrono::steady_clock::now();
+                m_result.tickMicros.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            }
+
+            m_result.evaluation = m_engine.GetEvaluationStats();
+            m_result.allocations = m_engine.GetAllocationStats();
+            return std::move(m_result);
+        }
+
+    private:
+        struct MonitorState {
+            KYL::ActorHandle probe{0};
+            KYL::ActorHandle target{0};
+            KYL::NodeRef base{nullptr};
+            KYL::NodeRef tip{nullptr};
+            KYL::NodeRef targetNode{nullptr};
+            KYL::MonitorSpec spec;
+            bool registered{false};
+            // Last live pose, to place the tip of samples played back from a learned loop
+            bool hasPose{false};
+            KYL::Vector3 basePos;
+            KYL::Vector3 tipPos;
+            float tipPenetration{0.0f};
+        };
+
+        void BuildScene() {
+            std::unordered_map<KYL::ActorHandle, KYL::ActorHandle> probes;
+            std::unordered_map<KYL::ActorHandle, KYL::ActorHandle> targets;
+            const auto actorFor = [this](auto& actors, KYL::ActorHandle recorded, const char* role) {
+                auto [it, added] = actors.try_emplace(recorded, 0);
+                if (added) {
+                    it->second = m_skeleton.AddActor(std::string{role} + " " + std::to_string(recorded));
+                }
+                return it->second;
+            };
+
+            const auto& monitors = m_recording.GetMonitors();
+            m_states.resize(monitors.size());
+            for (std::uint32_t m = 0; m < monitors.size(); ++m) {
+                auto& state = m_states[m];
+                state.probe = actorFor(probes, monitors[m].key.probe, "Probe");
+                state.target = actorFor(targets, monitors[m].key.target, "Target");
+
+                // Base and tip are roots placed from the recording; middle bones hang off the base so
+                // their writes never move the replayed tip
+                const std::string prefix = "Replay" + std::to_string(m) + " ";
+                for (std::size_t bone = 0; bone < monitors[m].chainLength; ++bone) {
+                    const std::string name = prefix + std::to_string(bone);
+                    const bool middle = bone > 0 && bone + 1 < monitors[m].chainLength;
+                    const auto node = m_skeleton.AddNode(state.probe, name, middle ? state.base : nullptr, {});
+                    if (bone == 0) {
+                        state.base = node;
+                    } else if (!middle) {
+                        state.tip = node;
+                    }
+                    m_boneOf.emplace(node, std::pair{m, static_cast<std::uint32_t>(bone)});
+                    state.spec.probeNodes.push_back(name);
+                }
+                state.spec.targetNode = prefix + "Target";
+                state.targetNode = m_skeleton.AddNode(state.target, state.spec.targetNode, nullptr, {});
+                state.spec.probeHandle = state.probe;
+                state.spec.targetHandle = state.target;
+            }
+        }
+
+        void ApplyFrame(const Frame& frame) {
+            const auto& samples = m_recording.GetSamples();
+            std::vector<KYL::MonitorSpec> changed;
+            for (std::size_t i = frame.begin; i < frame.end; ++i) {
+                const auto& sample = samples[i];
+                auto& state = m_states[m_recording.MonitorOf(i)];
+
+                // First sample registers the monitor; a threshold change (config reload) updates it
+                if (!state.registered || state.spec.distanceThreshold != sample.distanceThreshold ||
+                    state.spec.restoreThreshold != sample.restoreThreshold) {
+                    state.spec.distanceThreshold = sample.distanceThreshold;
+                    state.spec.restoreThreshold = sample.restoreThreshold;
+                    state.registered = true;
+                    changed.push_back(state.spec);
+                }
+
+                if (sample.source == KYL::SampleSource::Live) {
+                    state.basePos = sample.base;
+                    state.tipPos = sample.tip;
+                    m_skeleton.SetBindOffset(state.targetNode, sample.target);
+                } else if (state.hasPose) {
+                    // Played back: only the penetration is known, so slide the last tip along the probe
+                    const auto axis = state.tipPos - state.basePos;
+                    const float length = axis.Length();
+                    if (length > 0.0f) {
+                        state.tipPos = state.tipPos + axis * ((sample.tipPenetration - state.tipPenetration) / length);
+                    }
+                } else {
+                    continue;
+                }
+                state.hasPose = true;
+                state.tipPenetration = sample.tipPenetration;
+                m_skeleton.SetBindOffset(state.base, state.basePos);
+                m_skeleton.SetBindOffset(state.tip, state.tipPos);
+                m_skeleton.UpdateActor(state.probe);
+                m_skeleton.UpdateActor(state.target);
+            }
+
+            if (!changed.empty()) {
+                m_engine.AddMonitors(std::move(changed));
+            }
+        }
+
+        const Recording& m_recording;
+        KYL::MockSkeleton m_skeleton;
+        KYL::MonitorEngine m_engine;
+        std::vector<MonitorState> m_states;
+        // Probe bone -> (replay monitor, chain position)
+        std::unordered_map<KYL::NodeRef, std::pair<std::uint32_t, std::uint32_t>> m_boneOf;
+        std::uint64_t m_tick{0};
+        PassResult m_result;
+    };
+
+    bool WriteCsv(const std::string& path, const Recording& recording, const std::vector<BoneWrite>& writes) {
+        std::FILE* out = std::fopen(path.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "Cannot create %s\n", path.c_str());
+            return false;
+        }
+        std::fprintf(out, "tick,probe,target,monitor,bone,y\n");
+        for (const auto& write : writes) {
+            const auto& key = recording.GetMonitors()[write.monitor].key;
+            std::fprintf(out, "%llu,0x%08X,0x%08X,%u,%u,%.4f\n", static_cast<unsigned long long>(write.tick), key.probe,
+                         key.target, key.monitor, write.bone, write.y);
+        }
+        std::fclose(out);
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    ReplayOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<KYL::TickSample> samples;
+    std::string error;
+    if (!KYL::SampleRecorder::ReadFile(options.recordingPath, samples, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    const Recording recording(std::move(samples));
+    if (recording.GetFrames().empty()) {
+        std::fprintf(stderr, "%s holds no samples\n", options.recordingPath.c_str());
+        return 1;
+    }
+
+    std::vector<double> tickMicros;
+    std::optional<PassResult> first;
+    bool deterministic = true;
+    for (std::size_t pass = 0; pass < options.repeat; ++pass) {
+        auto result = ReplayPass(recording, options).Run();
+        tickMicros.insert(tickMicros.end(), result.tickMicros.begin(), result.tickMicros.end());
+        if (!first) {
+            first = std::move(result);
+        } else if (Digest(result.writes) != Digest(first->writes)) {
+            deterministic = false;
+        }
+    }
+
+    const auto& frames = recording.GetFrames();
+    const auto ticks = static_cast<double>(first->tickMicros.size());
+    const auto monitors = recording.GetMonitors().size();
+    const std::uint64_t digest = Digest(first->writes);
+    double total = 0.0;
+    for (const double sample : tickMicros) {
+        total += sample;
+    }
+    const double mean = total / static_cast<double>(tickMicros.size());
+
+    std::printf("replay: %zu sample(s), %zu monitor(s), ticks %llu-%llu, %zu pass(es)\n",
+                recording.GetSamples().size(), monitors, static_cast<unsigned long long>(frames.front().tick),
+                static_cast<unsigned long long>(frames.back().tick), options.repeat);
+    std::printf("tick mean=%.2fus p50=%.2fus p99=%.2fus max=%.2fus per-monitor=%.1fns\n", mean,
+                Percentile(tickMicros, 0.50), Percentile(tickMicros, 0.99),
+                *std::max_element(tickMicros.begin(), tickMicros.end()),
+                monitors > 0 ? mean * 1000.0 / static_cast<double>(monitors) : 0.0);
+    std::printf("evaluated per tick=%.1f (deferred %.1f, played back %.1f)\n",
+                static_cast<double>(first->evaluation.evaluated) / ticks,
+                static_cast<double>(first->evaluation.deferred) / ticks,
+                static_cast<double>(first->evaluation.playedBack) / ticks);
+    std::printf("bone writes=%zu (%.2f per tick) digest=%016" PRIx64 "%s\n", first->writes.size(),
+                static_cast<double>(first->writes.size()) / ticks, digest,
+                options.repeat > 1 ? (deterministic ? " (all passes match)" : " (PASSES DIFFER)") : "");
+    if (KYL::AllocationScope::IsEnabled()) {
+        std::printf("allocations: %llu in %llu of %llu steady-state tick(s)\n",
+                    static_cast<unsigned long long>(first->allocations.allocations),
+                    static_cast<unsigned long long>(first->allocations.ticksWithAllocations),
+                    static_cast<unsigned long long>(first->allocations.steadyTicks));
+    }
+
+    if (!options.writesPath.empty() && !WriteCsv(options.writesPath, recording, first->writes)) {
+        return 1;
+    }
+    if (!deterministic) {
+        std::fprintf(stderr, "Replay passes produced different bone writes\n");
+        return 1;
+    }
+    if (options.expectedDigest && *options.expectedDigest != digest) {
+        std::fprintf(stderr, "Digest %016" PRIx64 " does not match the expected %016" PRIx64 "\n", digest,
+                     *options.expectedDigest);
+        return 1;
+    }
+    return 0;
+}
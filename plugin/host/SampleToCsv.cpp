@@ -0,0 +1,66 @@
+// Converts a sample recording (SampleRecorder / KnowYourLimits.StartSampleRecording) to CSV, one row
+// per evaluated monitor and tick.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "SampleRecorder.h"
+
+namespace {
+    const char* GetActionName(KYL::SampleAction action) {
+        switch (action) {
+            case KYL::SampleAction::Shrink:
+                return "shrink";
+            case KYL::SampleAction::Restore:
+                return "restore";
+            default:
+                return "hold";
+        }
+    }
+
+    const char* GetSourceName(KYL::SampleSource source) {
+        return source == KYL::SampleSource::Playback ? "playback" : "live";
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::fprintf(stderr, "Usage: %s RECORDING [OUT.csv]\n  writes to stdout without OUT.csv\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<KYL::TickSample> samples;
+    std::string error;
+    if (!KYL::SampleRecorder::ReadFile(argv[1], samples, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    std::FILE* out = argc == 3 ? std::fopen(argv[2], "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot create %s\n", argv[2]);
+        return 1;
+    }
+
+    std::fprintf(out,
+                 "tick,time_us,probe,target,monitor,source,action,base_x,base_y,base_z,tip_x,tip_y,tip_z,target_x,"
+                 "target_y,target_z,tip_penetration,predicted_penetration,threshold,restore_threshold,offset,"
+                 "moved_mask,chain_length\n");
+    for (const auto& s : samples) {
+        std::fprintf(out,
+                     "%llu,%llu,0x%08X,0x%08X,%u,%s,%s,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,"
+                     "%.4f,%.4f,0x%X,%u\n",
+                     static_cast<unsigned long long>(s.tick), static_cast<unsigned long long>(s.timeUs),
+                     s.probeHandle, s.targetHandle, s.monitor, GetSourceName(s.source), GetActionName(s.action),
+                     s.base.x, s.base.y, s.base.z, s.tip.x, s.tip.y, s.tip.z, s.target.x, s.target.y, s.target.z,
+                     s.tipPenetration, s.predictedPenetration, s.distanceThreshold, s.restoreThreshold, s.offset,
+                     s.movedMask, s.chainLength);
+    }
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    std::fprintf(stderr, "%zu sample(s)\n", samples.size());
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "SyntheticScene.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace KYL {
+
+    SyntheticScene::SyntheticScene(MockSkeleton& skeleton, const Options& options)
+        : m_skeleton(skeleton), m_options(options) {
+        const std::size_t chainLength = std::max<std::size_t>(options.chainLength, 3);
+        const float meanTargetY = GetMeanTargetY();
+        const std::size_t targetsPerProbe = std::max<std::size_t>(options.targetsPerProbe, 1);
+
+        m_pairs.reserve(options.monitors);
+        m_specs.reserve(options.monitors);
+        for (std::size_t i = 0; i < options.monitors; ++i) {
+            Pair pair;
+            pair.phase = static_cast<float>(i) * 0.37f;
+            pair.ownsProbe = i % targetsPerProbe == 0;
+            if (pair.ownsProbe) {
+                pair.x = static_cast<float>(i / targetsPerProbe) * 100.0f;
+                pair.probe = m_skeleton.AddActor("Probe " + std::to_string(i / targetsPerProbe));
+            } else {
+                // Another action of the previous pair's probe, like one actor in two acts of a group scene
+                const auto& first = m_pairs[i - i % targetsPerProbe];
+                pair.x = first.x;
+                pair.probe = first.probe;
+                pair.tipNode = first.tipNode;
+            }
+            pair.target = m_skeleton.AddActor("Target " + std::to_string(i));
+
+            MonitorSpec spec;
+            spec.probeHandle = pair.probe;
+            spec.targetHandle = pair.target;
+            spec.targetNode = "NPC Pelvis [Pelv]";
+            spec.distanceThreshold = options.distanceThreshold;
+            spec.restoreThreshold = options.restoreThreshold;
+            spec.volume.probeRadius = options.volumeRadius;
+            spec.volume.targetRadius = options.volumeRadius;
+            if (!options.calibrationScene.empty()) {
+                spec.calibrationKey = options.calibrationScene + " " + std::to_string(i);
+            }
+
+            NodeRef parent = nullptr;
+            for (std::size_t bone = 0; bone < chainLength; ++bone) {
+                const std::string name = "Genitals0" + std::to_string(bone + 1);
+                if (pair.ownsProbe) {
+                    const Vector3 bind =
+                        bone == 0 ? Vector3{pair.x, 0.0f, 0.0f} : Vector3{0.0f, options.segmentLength, 0.0f};
+                    parent = m_skeleton.AddNode(pair.probe, name, parent, bind);
+                    if (bone == 0 && options.probeScale != 1.0f) {
+                        m_skeleton.SetScale(parent, options.probeScale);
+                    }
+                }
+                spec.probeNodes.push_back(name);
+            }
+            if (pair.ownsProbe) {
+                pair.tipNode = parent;
+                // The base bone's scale reaches bones added after it only on the next update
+                m_skeleton.UpdateActor(pair.probe);
+            }
+
+            pair.targetNode =
+                m_skeleton.AddNode(pair.target, spec.targetNode, nullptr, Vector3{pair.x, meanTargetY, 0.0f});
+
+            m_pairs.push_back(pair);
+            m_specs.push_back(std::move(spec));
+        }
+    }
+
+    void SyntheticScene::RegisterMonitors(MonitorEngine& engine) const {
+        // One batch, like a scene change registering all of its actions
+        engine.AddMonitors(m_specs);
+    }
+
+    float SyntheticScene::GetMeanTargetY() const {
+        const std::size_t chainLength = std::max<std::size_t>(m_options.chainLength, 3);
+        const float chainReach = m_options.segmentLength * m_options.probeScale * static_cast<float>(chainLength - 1);
+        // Mean target position sits just past the threshold so each loop crosses both thresholds. With
+        // volumes the target meets the chain head-on, so the overlap is the tip penetration plus both radii.
+        return chainReach - m_options.distanceThreshold + 2.0f * m_options.volumeRadius;
+    }
+
+    void SyntheticScene::Animate(std::size_t frame) {
+        const float meanY = GetMeanTargetY();
+
+        for (const auto& pair : m_pairs) {
+            const float angle = static_cast<float>(frame) * m_options.angularStep + pair.phase;
+            const float y = meanY - m_options.amplitude * std::sin(angle);
+            m_skeleton.SetBindOffset(pair.targetNode, Vector3{pair.x, y, 0.0f});
+            m_skeleton.UpdateActor(pair.target);
+            if (pair.ownsProbe) {
+                m_skeleton.UpdateActor(pair.probe);
+            }
+        }
+    }
+
+    float SyntheticScene::MeasureOvershoot() const {
+        float overshoot = 0.0f;
+        for (std::size_t i = 0; i < m_pairs.size(); ++i) {
+            overshoot += std::max(MeasureBeyondThreshold(i), 0.0f);
+        }
+        return overshoot;
+    }
+
+    float SyntheticScene::MeasureBeyondThreshold(std::size_t pair) const {
+        // Chains point along +Y, so penetration is the Y distance from target to tip; volumes overlap by
+        // that plus both radii until the tip reaches the target
+        const auto& entry = m_pairs[pair];
+        float penetration =
+            m_skeleton.GetWorldTranslate(entry.tipNode).y - m_skeleton.GetWorldTranslate(entry.targetNode).y;
+        if (m_options.volumeRadius > 0.0f) {
+            penetration = std::min(penetration, 0.0f) + 2.0f * m_options.volumeRadius;
+        }
+        return penetration - m_options.distanceThreshold;
+    }
+
+}  // namespace KYL
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "MockSkeleton.h"
+#include "MonitorEngine.h"
+
+namespace KYL {
+
+    // Synthetic scene for host benchmarks: N probe/target actor pairs whose poses oscillate so that
+    // every monitor periodically crosses both thresholds, like a looping paired animation.
+    class SyntheticScene {
+    public:
+        struct Options {
+            std::size_t monitors{200};
+            std::size_t chainLength{5};     // base + middle bones + tip
+            std::size_t targetsPerProbe{1}; // monitors sharing one probe chain, each with its own target
+            float segmentLength{3.0f};      // bind-pose distance between consecutive probe bones
+            float distanceThreshold{3.0f};
+            float restoreThreshold{-1.0f};
+            float amplitude{5.0f};          // how far the target travels around its mean position
+            float angularStep{0.15f};       // phase advance per frame
+            float volumeRadius{0.0f};       // when set, monitors use the volume test with this probe and target radius
+            float probeScale{1.0f};         // scale on each probe chain's base bone, like actor or genital size scaling
+            std::string calibrationScene;   // when set, monitor i is cached as "<scene> <i>"
+        };
+
+        SyntheticScene(MockSkeleton& skeleton, const Options& options);
+
+        // Register one monitor per probe/target pair
+        void RegisterMonitors(MonitorEngine& engine) const;
+
+        // Advance the animation by one frame and recompute world transforms
+        void Animate(std::size_t frame);
+
+        // Visual error of the current pose: how far tips sit past (or volumes overlap beyond) the shrink
+        // threshold, summed over pairs
+        float MeasureOvershoot() const;
+
+        // How far pair i's tip sits past (or its volumes overlap beyond) the shrink threshold; negative below it
+        float MeasureBeyondThreshold(std::size_t pair) const;
+
+        std::size_t GetPairCount() const { return m_pairs.size(); }
+
+        const Options& GetOptions() const { return m_options; }
+        const std::vector<MonitorSpec>& GetSpecs() const { return m_specs; }
+
+    private:
+        // Target position around which each pair oscillates
+        float GetMeanTargetY() const;
+
+        struct Pair {
+            ActorHandle probe{0};
+            ActorHandle target{0};
+            NodeRef targetNode{nullptr};
+            NodeRef tipNode{nullptr};
+            float x{0.0f};
+            float phase{0.0f};
+            // First pair of its probe; the probe's pose is updated through it
+            bool ownsProbe{true};
+        };
+
+        MockSkeleton& m_skeleton;
+        Options m_options;
+        std::vector<Pair> m_pairs;
+        std::vector<MonitorSpec> m_specs;
+    };
+
+}  // namespace KYL
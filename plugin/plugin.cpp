@@ -6,25 +6,44 @@
 #include <atomic>
 #include <chrono>
 #include <cmath>
-#include <condition_variable>
 #include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <mutex>
-#include <set>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <system_error>
-#include <thread>
 #include <utility>
 #include <vector>
 
 #include "PCH.h"
 #include "RE/N/NiAVObject.h"
 #include "RE/R/ReferenceArray.h"
+#include "CalibrationCache.h"
+#include "FramePacer.h"
 #include "Logger.h"
+#include "MonitorEngine.h"
+#include "PluginConfig.h"
+#include "SampleRecorder.h"
+#include "ScenePlanCache.h"
+#include "SkseSkeleton.h"
+#include "TickScheduler.h"
+#include "Tracer.h"
 
 namespace {
+    // Directory of this DLL (Data/SKSE/Plugins), where the INI and the KnowYourLimits folder live
+    std::optional<std::filesystem::path> GetPluginDirectory() {
+        HMODULE hModule = nullptr;
+        if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                                reinterpret_cast<LPCSTR>(&GetPluginDirectory), &hModule)) {
+            return std::nullopt;
+        }
+        char dllPath[MAX_PATH];
+        GetModuleFileNameA(hModule, dllPath, MAX_PATH);
+        return std::filesystem::path(dllPath).parent_path();
+    }
+
     // Task interface pointer is obtained on demand using SKSE::GetTaskInterface();
     void SetupLogging() {
         auto logDir = SKSE::log::log_directory();
@@ -42,12 +61,8 @@ namespace {
 
         // Get the DLL path for INI file location
         std::filesystem::path iniPath;
-        HMODULE hModule = nullptr;
-        if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
-                               (LPCSTR)&SetupLogging, &hModule)) {
-            char dllPath[MAX_PATH];
-            GetModuleFileNameA(hModule, dllPath, MAX_PATH);
-            iniPath = std::filesystem::path(dllPath).parent_path() / "KnowYourLimits.ini";
+        if (const auto pluginDir = GetPluginDirectory()) {
+            iniPath = *pluginDir / "KnowYourLimits.ini";
         } else {
             // Fallback to log directory
             iniPath = logPath.parent_path() / "KnowYourLimits.ini";
@@ -64,21 +79,7 @@ namespace {
         }
     }
 
-    std::string GetActorName(RE::Actor* actor) {
-        if (!actor) {
-            return "<none>";
-        }
-
-        if (const char* name = actor->GetDisplayFullName(); name && *name != '\0') {
-            return name;
-        }
-
-        if (const char* baseName = actor->GetName(); baseName && *baseName != '\0') {
-            return baseName;
-        }
-
-        return "<unnamed>";
-    }
+    std::string GetActorName(RE::Actor* actor) { return KYL::SkseSkeleton::GetActorName(actor); }
 
     std::string_view GetNodeLabel(const RE::BSFixedString& nodeName) {
         const char* data = nodeName.data();
@@ -99,339 +100,304 @@ namespace {
 
 
     namespace Monitoring {
-        struct MonitorEntry {
-            std::uint32_t probeHandle{0};
-            std::uint32_t targetHandle{0};
-            std::vector<RE::BSFixedString> probeNodes;
-            RE::BSFixedString targetNode;
-            // monitors are indefinite (stopped via StopBoneMonitor)
-            float distanceThreshold{0.0f};
-            float restoreThreshold{0.0f};
-            std::vector<bool> movedFlags;
-            bool waitingForBones{false};
-            // Cached bone pointers to avoid per-tick lookups
-            RE::NiPointer<RE::NiAVObject> cachedBaseNode;
-            RE::NiPointer<RE::NiAVObject> cachedTipNode;
-            std::vector<RE::NiPointer<RE::NiAVObject>> cachedMiddleBones;
-            // Track maximum penetration depth reached
-            float maxPenetration{0.0f};
-            // Track maximum penetration beyond threshold to minimize repeated bone updates
-            float maxPenetrationBeyondThreshold{0.0f};
-        };
+        // Penetration logic lives in KYLCore; this namespace only adapts it to SKSE threading
+        KYL::SkseSkeleton s_skeleton;
+        KYL::MonitorEngine s_engine{s_skeleton};
 
-        std::mutex s_monitorMutex;
-        std::vector<MonitorEntry> s_monitors;
+        // When the tick now in the task queue was posted (steady_clock count), for its queue delay
+        std::atomic<std::chrono::steady_clock::rep> s_tickPostedAt{0};
 
-        std::mutex s_uiTickMutex;
-        std::atomic<bool> s_uiTickActive{false};
-        std::chrono::steady_clock::time_point s_lastTickTime{};
+        // Tick-thread only: when the periodic stats line was last written
+        std::chrono::steady_clock::time_point s_lastStatsLog{};
+        constexpr auto kStatsLogInterval = std::chrono::seconds{60};
 
-        // Configurable tick interval - can be set from Papyrus, defaults to 50ms
-        std::atomic<int> s_tickIntervalMs{50};
-
-        // Shutdown synchronization for background thread
-        std::atomic<bool> s_shutdownRequested{false};
-        std::condition_variable s_shutdownCV;
-        std::mutex s_shutdownMutex;
+        void ProcessTick();
 
-        // Run the monitor tick at most 4 times per second to avoid UI thread churn.
-        constexpr float kPositionTolerance = 0.1f;  // Tolerance for position comparisons
-        constexpr float kMaxBoneOffset = 1.3f;      // Maximum bone offset to prevent runaway feedback
+        bool PostTickToUIThread() {
+            auto* task = SKSE::GetTaskInterface();
+            if (!task) {
+                LOG_CRITICAL("Task interface unavailable; stopping monitor updates.");
+                return false;
+            }
 
-        void ProcessTick();
+            s_tickPostedAt.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                 std::memory_order_relaxed);
+            task->AddUITask([]() { ProcessTick(); });
+            return true;
+        }
 
-        void SetTickInterval(int intervalMs) {
-            // Clamp interval to reasonable bounds (16ms to 1000ms)
-            const int clampedInterval = std::clamp(intervalMs, 16, 1000);
-            s_tickIntervalMs.store(clampedInterval, std::memory_order_relaxed);
-            LOG_INFO("Tick interval set to {}ms", clampedInterval);
+        KYL::TickScheduler& GetScheduler() {
+            // Leaked with its timer thread (see the note at the end of this file). Defaults to a 50ms
+            // fixed-rate cadence.
+            static auto* scheduler = new KYL::TickScheduler(PostTickToUIThread);
+            return *scheduler;
         }
 
-        int GetTickInterval() {
-            return s_tickIntervalMs.load(std::memory_order_relaxed);
+        KYL::CalibrationCache& GetCalibrationCache() {
+            // Leaked; whatever reached the mapping is persisted by the OS even without a clean shutdown
+            static auto* cache = new KYL::CalibrationCache();
+            return *cache;
         }
 
-        void QueueTick() {
-            // Use atomic for quick check without lock
-            if (s_uiTickActive.load(std::memory_order_acquire)) {
+        void OpenCalibrationCache() {
+            auto directory = SKSE::log::log_directory();
+            if (!directory) {
+                LOG_WARN("Calibration cache disabled: SKSE directory unavailable");
                 return;
             }
-
-            std::lock_guard<std::mutex> lk(s_uiTickMutex);
-            // Double-check after acquiring lock
-            if (s_uiTickActive.load(std::memory_order_relaxed)) {
-                return;
+            if (GetCalibrationCache().Open(*directory / "KnowYourLimits.calibration")) {
+                s_engine.SetCalibrationCache(&GetCalibrationCache());
             }
+        }
 
-            if (auto* task = SKSE::GetTaskInterface()) {
-                s_uiTickActive.store(true, std::memory_order_release);
-                s_lastTickTime = std::chrono::steady_clock::now();
-                task->AddUITask([]() { ProcessTick(); });
-            } else {
-                LOG_CRITICAL("Task interface unavailable; cannot start monitor updates.");
-            }
+        KYL::SampleRecorder& GetSampleRecorder() {
+            // Leaked; a tick still holding it after a stop finds it idle
+            static auto* recorder = new KYL::SampleRecorder();
+            return *recorder;
         }
 
-        void ScheduleNextTick() {
-            // Check for shutdown before scheduling
-            if (s_shutdownRequested.load(std::memory_order_acquire)) {
-                s_uiTickActive.store(false, std::memory_order_release);
-                return;
+        bool StartSampleRecording(std::string_view fileName) {
+            auto directory = SKSE::log::log_directory();
+            if (!directory) {
+                LOG_WARN("Sample recording unavailable: SKSE directory unavailable");
+                return false;
             }
-
-            auto* task = SKSE::GetTaskInterface();
-            if (!task) {
-                s_uiTickActive.store(false, std::memory_order_release);
-                LOG_CRITICAL("Task interface unavailable; stopping monitor updates.");
-                return;
+            // Recordings always go next to the log; anything but the file name is ignored
+            const std::filesystem::path name =
+                fileName.empty() ? std::filesystem::path{"KnowYourLimits.samples"} : std::filesystem::path{fileName}.filename();
+            if (!GetSampleRecorder().Start(*directory / name)) {
+                return false;
             }
+            s_engine.SetSampleRecorder(&GetSampleRecorder());
+            return true;
+        }
 
-            // Use a detached thread for the sleep, but with shutdown awareness
-            // This thread is short-lived (just sleeps then queues) so detach is acceptable
-            std::thread([task]() {
-                const auto intervalMs = s_tickIntervalMs.load(std::memory_order_relaxed);
-                const auto interval = std::chrono::milliseconds{intervalMs};
-
-                // Use condition variable for interruptible sleep
-                {
-                    std::unique_lock<std::mutex> lk(s_shutdownMutex);
-                    if (s_shutdownCV.wait_for(lk, interval, []() {
-                            return s_shutdownRequested.load(std::memory_order_acquire);
-                        })) {
-                        // Shutdown was requested during sleep
-                        s_uiTickActive.store(false, std::memory_order_release);
-                        return;
-                    }
-                }
-
-                // Check shutdown again after waking
-                if (s_shutdownRequested.load(std::memory_order_acquire)) {
-                    s_uiTickActive.store(false, std::memory_order_release);
-                    return;
-                }
+        // Returns how many samples were written
+        int StopSampleRecording() {
+            s_engine.SetSampleRecorder(nullptr);
+            GetSampleRecorder().Stop();
+            return static_cast<int>(GetSampleRecorder().GetStats().written);
+        }
 
-                // Queue the actual processing on UI thread
-                task->AddUITask([]() {
-                    s_lastTickTime = std::chrono::steady_clock::now();
-                    ProcessTick();
-                });
-            }).detach();
+        // Writes the spans recorded since StartTrace next to the log; returns how many were written, or -1
+        int StopTrace(std::string_view fileName) {
+            auto directory = SKSE::log::log_directory();
+            if (!directory) {
+                LOG_WARN("Trace unavailable: SKSE directory unavailable");
+                return -1;
+            }
+            const std::filesystem::path name = fileName.empty() ? std::filesystem::path{"KnowYourLimits.trace.json"}
+                                                                : std::filesystem::path{fileName}.filename();
+            std::size_t spans = 0;
+            if (!KYL::Tracer::Stop(*directory / name, &spans)) {
+                return -1;
+            }
+            return static_cast<int>(spans);
         }
 
-        void StopAllMonitoring() {
-            // Signal shutdown to any sleeping threads
-            s_shutdownRequested.store(true, std::memory_order_release);
-            s_shutdownCV.notify_all();
+        // Frame-synchronized mode: ticks run from the main-thread update hook on every Nth frame
+        // instead of from the timer thread
+        KYL::FramePacer s_framePacer;
+        std::atomic<bool> s_frameSyncEnabled{false};
+        std::atomic<bool> s_frameTickActive{false};
 
-            s_uiTickActive.store(false, std::memory_order_release);
-            LOG_INFO("Monitoring system stopped.");
+        void SetTickInterval(int intervalMs) {
+            // Clamp interval to reasonable bounds (16ms to 1000ms)
+            const int clampedInterval = std::clamp(intervalMs, 16, 1000);
+            GetScheduler().SetInterval(std::chrono::milliseconds{clampedInterval});
+            LOG_INFO("Tick interval set to {}ms", clampedInterval);
         }
 
-        void ResetShutdownState() {
-            // Called when starting fresh monitoring after a shutdown
-            s_shutdownRequested.store(false, std::memory_order_release);
+        int GetTickInterval() {
+            return static_cast<int>(GetScheduler().GetInterval().count());
         }
 
-        void UpdateNodeWorldData(RE::NiAVObject* node) {
-            if (!node) {
+        void QueueTick() {
+            KYL_TRACE_SPAN("QueueTick");
+            if (s_frameSyncEnabled.load(std::memory_order_acquire)) {
+                if (!s_frameTickActive.exchange(true, std::memory_order_acq_rel)) {
+                    s_framePacer.Restart();
+                }
                 return;
             }
 
-            RE::NiUpdateData updateData;
-            node->UpdateWorldData(&updateData);
+            // Starts the persistent timer thread on first use; no-op while already running
+            GetScheduler().Resume();
         }
 
-        void RestoreBonePosition(RE::Actor* actor, const RE::BSFixedString& nodeName) {
-            if (!actor) {
+        void SetTickFrameDivisor(int frames) {
+            auto& scheduler = GetScheduler();
+
+            if (frames <= 0) {
+                if (s_frameSyncEnabled.exchange(false, std::memory_order_acq_rel) &&
+                    s_frameTickActive.exchange(false, std::memory_order_acq_rel)) {
+                    // Hand running monitors back to the timer thread
+                    scheduler.Resume();
+                }
+                LOG_INFO("Frame-synchronized ticks disabled; using {}ms timer", scheduler.GetInterval().count());
                 return;
             }
 
-            auto* node = actor->GetNodeByName(nodeName);
+            // Clamp divisor to reasonable bounds (every frame to once per 60 frames)
+            const int clampedFrames = std::clamp(frames, 1, 60);
+            s_framePacer.SetDivisor(static_cast<std::uint32_t>(clampedFrames));
 
-            if (!node) {
-                LOG_WARN("RestoreBone: bone {} not found on actor {}", nodeName, GetActorName(actor));
-                return;
+            if (!s_frameSyncEnabled.exchange(true, std::memory_order_acq_rel) && scheduler.IsRunning()) {
+                // Take running monitors over from the timer thread
+                scheduler.Pause();
+                s_frameTickActive.store(true, std::memory_order_release);
+                s_framePacer.Restart();
             }
+            LOG_INFO("Frame-synchronized ticks enabled (every {} frame(s))", clampedFrames);
+        }
 
-            LOG_TRACE("RestoreBone: {} restoring to originalY={:.3f}", nodeName.c_str(), 0.0f);
-
-            node->local.translate = RE::NiPoint3{0.0f, 0.0f, 0.0f};
+        int GetTickFrameDivisor() {
+            return s_frameSyncEnabled.load(std::memory_order_acquire) ? static_cast<int>(s_framePacer.GetDivisor()) : 0;
+        }
 
-            UpdateNodeWorldData(node);
+        void SetPredictionLookAhead(float ticks) {
+            s_engine.SetLookAheadTicks(ticks);
+            LOG_INFO("Prediction look-ahead set to {:.2f} tick(s)", s_engine.GetLookAheadTicks());
         }
 
-        RE::NiPointer<RE::Actor> LookupActorByHandle(std::uint32_t handle) {
-            RE::NiPointer<RE::Actor> actor;
-            RE::Actor::LookupByHandle(static_cast<RE::RefHandle>(handle), actor);
-            return actor;
+        float GetPredictionLookAhead() { return s_engine.GetLookAheadTicks(); }
+
+        void SetLoopLearning(bool enabled) { s_engine.SetLoopLearning(enabled); }
+
+        bool IsLoopLearningEnabled() { return s_engine.IsLoopLearningEnabled(); }
+
+        KYL::ConfigStore& GetConfigStore() {
+            // Leaked; its watcher keeps polling config.json until the process exits
+            static auto* store = new KYL::ConfigStore();
+            return *store;
         }
 
-        void RestoreMiddleBonesForEntry(const Monitoring::MonitorEntry& entry) {
-            RE::NiPointer<RE::Actor> probeActor = LookupActorByHandle(entry.probeHandle);
-            if (!probeActor) {
-                return;
-            }
+        // Scene plans outlive game loads: scene metadata does not change while the game runs
+        KYL::ScenePlanCache s_scenePlans;
 
-            for (std::size_t idx = 1; idx < entry.probeNodes.size() - 1; ++idx) {
-                if (entry.movedFlags[idx]) {
-                    RestoreBonePosition(probeActor.get(), entry.probeNodes[idx]);
-                    LOG_TRACE("Restored bone {} for actor {}", GetNodeLabel(entry.probeNodes[idx]),
-                                    GetActorName(probeActor.get()));
-                }
+        // General settings of the last applied config; reloads are serialized by the config store
+        std::optional<KYL::GeneralConfig> s_appliedGeneral;
+
+        // Runs after every successful (re)load, so editing config.json retunes a running game. Only settings
+        // whose value in the file changed are applied: a save that leaves them alone keeps what the Papyrus
+        // setters changed at runtime, and does not re-anchor the scheduler.
+        void ApplyGeneralConfig(const KYL::PluginConfig& config) {
+            const auto& general = config.general;
+            const auto* previous = s_appliedGeneral ? &*s_appliedGeneral : nullptr;
+            if (!previous || previous->intervalMs != general.intervalMs) {
+                SetTickInterval(general.intervalMs);
             }
+            if (!previous || previous->frameDivisor != general.frameDivisor) {
+                SetTickFrameDivisor(general.frameDivisor);
+            }
+            if (!previous || previous->lookAheadTicks != general.lookAheadTicks) {
+                SetPredictionLookAhead(general.lookAheadTicks);
+            }
+            if (!previous || previous->loopLearning != general.loopLearning) {
+                SetLoopLearning(general.loopLearning);
+            }
+            s_appliedGeneral = general;
         }
 
-        void MoveBoneToTarget(RE::Actor* actor, const RE::BSFixedString& nodeName, float penetrationDepth) {
-            if (!actor) {
+        void OpenConfig() {
+            const auto pluginDir = GetPluginDirectory();
+            if (!pluginDir) {
+                LOG_WARN("Config: plugin directory unavailable, using defaults");
                 return;
             }
+            GetConfigStore().Open(*pluginDir / "KnowYourLimits" / "config.json", ApplyGeneralConfig);
+        }
 
-            auto* node = actor->GetNodeByName(nodeName);
-
-            if (!node) {
-                LOG_WARN("MoveBone: bone {} not found on actor {}", nodeName, GetActorName(actor));
-                return;
+        void LogMonitorStats() {
+            s_lastStatsLog = std::chrono::steady_clock::now();
+            if (s_engine.GetMetrics().tickUs.Summarize().count > 0) {
+                LOG_INFO("Monitor stats: {}", s_engine.GetMetrics().Format());
             }
-            // Calculate how much to move the bone backwards along Y axis
-            // penetrationDepth is how far beyond threshold the bone has gone
-            float yOffset = -penetrationDepth;
-
-            // Apply offset to ORIGINAL position, not current position
-            RE::NiPoint3 newPos = RE::NiPoint3{0.0f, 0.0f, 0.0f};
-            newPos.y += yOffset;
-
-            // Check if bone is already at target position (within tolerance)
-            const float currentY = node->local.translate.y;
-            const float deltaY = std::abs(currentY - newPos.y);
+        }
 
-            if (deltaY < kPositionTolerance) {
-                // Already at target position, no need to update
-                return;
+        // Called after every tick; the line is cheap to skip, so the check runs on the tick thread
+        void MaybeLogMonitorStats() {
+            if (std::chrono::steady_clock::now() - s_lastStatsLog >= kStatsLogInterval) {
+                LogMonitorStats();
             }
+        }
 
-            LOG_TRACE("MoveBone: {} originalY={:.3f} offset={:.3f} newY={:.3f}", nodeName.c_str(), 0.0f, yOffset,
-                            newPos.y);
+        void LogSchedulerStats() {
+            auto& scheduler = GetScheduler();
+            const auto stats = scheduler.GetStats();
+            if (stats.posted > 0) {
+                LOG_INFO("Tick scheduler: {} tick(s) posted, {} late, {} skipped (worst lateness {}us)", stats.posted,
+                         stats.late, stats.skipped, stats.maxLatenessUs);
+            }
+            scheduler.ResetStats();
+            LogMonitorStats();
 
-            node->local.translate = newPos;
+            if (const auto dropped = KYL::Logger::GetInstance().GetDroppedCount(); dropped > 0) {
+                LOG_WARN("Logger: {} message(s) dropped because the log queue was full", dropped);
+            }
+        }
 
-            UpdateNodeWorldData(node);
+        void StopAllMonitoring() {
+            // Wakes the timer thread and stops it from posting further ticks
+            GetScheduler().Pause();
+            s_frameTickActive.store(false, std::memory_order_release);
+            LogSchedulerStats();
+            LOG_INFO("Monitoring system stopped.");
         }
 
-        bool AddMonitor(RE::Actor* probeActor, const std::vector<RE::BSFixedString>& probeNodeNames,
-                        RE::Actor* targetActor, const RE::BSFixedString& targetNodeName, float distanceThreshold,
-                        float restoreThreshold) {
+        // Both calls only queue the change for the tick and wake it; they never wait for a running pass
+        KYL::CommandTicket AddMonitor(RE::Actor* probeActor, const std::vector<RE::BSFixedString>& probeNodeNames,
+                                      RE::Actor* targetActor, const RE::BSFixedString& targetNodeName,
+                                      float distanceThreshold, float restoreThreshold,
+                                      std::string calibrationKey, KYL::VolumeSpec volume = {}) {
             if (!probeActor || !targetActor) {
                 LOG_WARN("AddMonitor rejected null actors (probe={}, target={})",
                                 static_cast<const void*>(probeActor), static_cast<const void*>(targetActor));
-                return false;
-            }
-
-            if (probeNodeNames.empty()) {
-                LOG_WARN("AddMonitor rejected empty probe node list.");
-                return false;
+                return 0;
             }
 
-            // Monitors created by AddMonitor run indefinitely until stopped.
-            // Don't clamp thresholds - allow negative values for pre-emptive scaling
-            const auto probeHandle = probeActor->GetHandle().native_handle();
-            const auto targetHandle = targetActor->GetHandle().native_handle();
-
-            if (probeHandle == 0 || targetHandle == 0) {
-                LOG_WARN("AddMonitor received actor with invalid handle (probe={}, target={})", probeHandle,
-                                targetHandle);
-                return false;
+            KYL::MonitorSpec spec;
+            spec.probeHandle = probeActor->GetHandle().native_handle();
+            spec.targetHandle = targetActor->GetHandle().native_handle();
+            spec.probeNodes.reserve(probeNodeNames.size());
+            for (const auto& name : probeNodeNames) {
+                spec.probeNodes.emplace_back(name.c_str());
             }
-
-            bool updated = false;
-            {
-                std::lock_guard<std::mutex> lock(s_monitorMutex);
-                for (auto& entry : s_monitors) {
-                    if (entry.probeHandle == probeHandle && entry.targetHandle == targetHandle &&
-                        entry.targetNode == targetNodeName) {
-                        entry.probeNodes = probeNodeNames;
-                        entry.distanceThreshold = distanceThreshold;
-                        entry.restoreThreshold = restoreThreshold;
-                        entry.movedFlags.resize(entry.probeNodes.size(), false);
-                        entry.waitingForBones = false;
-                        entry.cachedBaseNode.reset();
-                        entry.cachedTipNode.reset();
-                        entry.cachedMiddleBones.clear();
-                        entry.maxPenetration = 0.0f;
-                        entry.maxPenetrationBeyondThreshold = 0.0f;
-                        updated = true;
-                        break;
-                    }
-                }
-
-                if (!updated) {
-                    MonitorEntry newEntry{};
-                    newEntry.probeHandle = probeHandle;
-                    newEntry.targetHandle = targetHandle;
-                    newEntry.probeNodes = probeNodeNames;
-                    newEntry.targetNode = targetNodeName;
-                    newEntry.distanceThreshold = distanceThreshold;
-                    newEntry.restoreThreshold = restoreThreshold;
-                    newEntry.movedFlags.resize(probeNodeNames.size(), false);
-                    newEntry.waitingForBones = false;
-                    newEntry.cachedMiddleBones.resize(probeNodeNames.size());
-                    newEntry.maxPenetration = 0.0f;
-                    newEntry.maxPenetrationBeyondThreshold = 0.0f;
-                    s_monitors.push_back(std::move(newEntry));
-                }
+            spec.targetNode = targetNodeName.c_str();
+            spec.distanceThreshold = distanceThreshold;
+            spec.restoreThreshold = restoreThreshold;
+            spec.volume = std::move(volume);
+            spec.calibrationKey = std::move(calibrationKey);
+
+            const auto ticket = s_engine.AddMonitor(std::move(spec));
+            if (ticket != 0) {
+                QueueTick();
             }
-
-            LOG_INFO(
-                "{} bone monitor for {}.[{}] -> {}.{} (shrink threshold {:.2f}, restore threshold {:.2f}, lifetime "
-                "indefinite)",
-                updated ? "Updated" : "Created", GetActorName(probeActor), JoinNodeLabels(probeNodeNames),
-                GetActorName(targetActor), GetNodeLabel(targetNodeName), distanceThreshold, restoreThreshold);
-
-            // Reset shutdown state in case we're starting fresh after a previous shutdown
-            ResetShutdownState();
-            QueueTick();
-            return true;
+            return ticket;
         }
 
-        std::size_t RemoveMonitors(const std::vector<std::uint32_t>& handles) {
-            std::size_t removed = 0;
-            bool emptyAfter = false;
-
-            {
-                std::lock_guard<std::mutex> lock(s_monitorMutex);
-                if (handles.empty()) {
-                    // Restore all bones before clearing all monitors
-                    for (auto& entry : s_monitors) {
-                        RestoreMiddleBonesForEntry(entry);
-                    }
-                    removed = s_monitors.size();
-                    s_monitors.clear();
-                } else {
-                    // Use a set for O(1) lookup instead of O(n) linear search
-                    const std::set<std::uint32_t> handleSet(handles.begin(), handles.end());
-
-                    auto shouldRemove = [&handleSet](const MonitorEntry& entry) {
-                        return handleSet.contains(entry.probeHandle) || handleSet.contains(entry.targetHandle);
-                    };
-
-                    const auto before = s_monitors.size();
-                    // Restore bones for monitors being removed
-                    for (auto& entry : s_monitors) {
-                        if (shouldRemove(entry)) {
-                            RestoreMiddleBonesForEntry(entry);
-                        }
-                    }
-                    std::erase_if(s_monitors, shouldRemove);
-                    removed = before - s_monitors.size();
-                }
-
-                emptyAfter = s_monitors.empty();
+        // Queues a whole scene as one command and wakes the tick once
+        KYL::CommandTicket AddMonitors(std::vector<KYL::MonitorSpec> specs) {
+            const auto ticket = s_engine.AddMonitors(std::move(specs));
+            if (ticket != 0) {
+                QueueTick();
             }
+            return ticket;
+        }
 
-            if (emptyAfter) {
-                StopAllMonitoring();
+        KYL::CommandTicket ApplyMonitorSet(std::vector<std::uint32_t> actors, std::vector<KYL::MonitorSpec> specs) {
+            const auto ticket = s_engine.ApplyMonitorSet(std::move(actors), std::move(specs));
+            if (ticket != 0) {
+                QueueTick();
             }
+            return ticket;
+        }
 
-            return removed;
+        KYL::CommandTicket RemoveMonitors(std::vector<std::uint32_t> handles) {
+            // The tick applies the removal and stops itself once no monitors remain
+            const auto ticket = s_engine.RemoveMonitors(std::move(handles));
+            QueueTick();
+            return ticket;
         }
 
         void Shutdown() {
@@ -441,243 +407,188 @@ namespace {
             StopAllMonitoring();
 
             // Restore all bones and clear monitors
-            {
-                std::lock_guard<std::mutex> lock(s_monitorMutex);
-                const auto count = s_monitors.size();
-
-                // Restore all moved bones to their original positions
-                for (auto& entry : s_monitors) {
-                    RestoreMiddleBonesForEntry(entry);
-                }
-
-                s_monitors.clear();
-                if (count > 0) {
-                    LOG_INFO("Cleared {} monitor(s)", count);
-                }
+            if (const auto count = s_engine.Clear(); count > 0) {
+                LOG_INFO("Cleared {} monitor(s)", count);
             }
+            // Cost figures describe one play session
+            s_engine.GetMetrics().Reset();
 
             LOG_INFO("Monitoring system shutdown complete.");
         }
 
         void ProcessTick() {
-            // Check for shutdown request
-            if (s_shutdownRequested.load(std::memory_order_acquire)) {
-                s_uiTickActive.store(false, std::memory_order_release);
+            KYL_TRACE_SPAN("ProcessTick");
+            const std::chrono::steady_clock::duration queueDelay{
+                std::chrono::steady_clock::now().time_since_epoch().count() -
+                s_tickPostedAt.load(std::memory_order_relaxed)};
+            auto& scheduler = GetScheduler();
+
+            // Monitoring was stopped while this tick was queued
+            if (!scheduler.IsRunning()) {
+                scheduler.OnTickComplete();
                 return;
             }
 
-            // Work with monitors directly instead of copying to avoid corrupting NiPoint3 data
-            std::lock_guard<std::mutex> lock(s_monitorMutex);
+            s_engine.GetMetrics().queueDelayUs.Record(static_cast<std::uint64_t>(
+                std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(queueDelay).count(), 0)));
+            if (!s_engine.Tick()) {
+                scheduler.Pause();
+                LogSchedulerStats();
 
-            if (s_monitors.empty()) {
-                // Use atomic instead of mutex to avoid potential deadlock
-                s_uiTickActive.store(false, std::memory_order_release);
-                return;
+                // A command queued before the pause saw the scheduler still running and did not resume it
+                if (s_engine.HasPendingCommands()) {
+                    scheduler.Resume();
+                }
             }
+            MaybeLogMonitorStats();
 
-            // Track which monitors to remove
-            std::vector<std::size_t> monitorsToRemove;
-
-            for (std::size_t monitorIdx = 0; monitorIdx < s_monitors.size(); ++monitorIdx) {
-                auto& entry = s_monitors[monitorIdx];
+            scheduler.OnTickComplete();
+        }
 
-                if (entry.probeNodes.empty()) {
-                    LOG_WARN("Removing monitor with no probe nodes (probeHandle={:#x} targetHandle={:#x})",
-                                    entry.probeHandle, entry.targetHandle);
-                    monitorsToRemove.push_back(monitorIdx);
-                    continue;
-                }
+        void OnMainThreadFrame() {
+            if (!s_frameSyncEnabled.load(std::memory_order_acquire) ||
+                !s_frameTickActive.load(std::memory_order_acquire)) {
+                return;
+            }
 
-                RE::NiPointer<RE::Actor> probeActor = LookupActorByHandle(entry.probeHandle);
-                const bool probeValid = static_cast<bool>(probeActor);
+            if (!s_framePacer.OnFrame()) {
+                return;
+            }
 
-                RE::NiPointer<RE::Actor> targetActor = LookupActorByHandle(entry.targetHandle);
-                const bool targetValid = static_cast<bool>(targetActor);
+            if (!s_engine.Tick()) {
+                s_frameTickActive.store(false, std::memory_order_release);
 
-                if (!probeValid || !targetValid) {
-                    LOG_INFO("Removing monitor (missing actor) probeHandle={:#x} targetHandle={:#x}",
-                                    entry.probeHandle, entry.targetHandle);
-                    monitorsToRemove.push_back(monitorIdx);
-                    continue;
+                // A command queued before the flag dropped did not re-arm frame ticks
+                if (s_engine.HasPendingCommands()) {
+                    s_frameTickActive.store(true, std::memory_order_release);
                 }
+            }
+            MaybeLogMonitorStats();
+        }
+    }  // namespace Monitoring
+}  // namespace
 
-                // monitors are indefinite; expiration check removed
-
-                entry.movedFlags.resize(entry.probeNodes.size(), false);
-                entry.cachedMiddleBones.resize(entry.probeNodes.size());
-
-                auto* targetNode = targetActor->GetNodeByName(entry.targetNode);
-
-                // Get base (first) and tip (last) bones for direction/distance calculation
-                if (!entry.cachedBaseNode) {
-                    entry.cachedBaseNode =
-                        RE::NiPointer<RE::NiAVObject>(probeActor->GetNodeByName(entry.probeNodes[0]));
-                }
-                if (!entry.cachedTipNode) {
-                    entry.cachedTipNode = RE::NiPointer<RE::NiAVObject>(
-                        probeActor->GetNodeByName(entry.probeNodes[entry.probeNodes.size() - 1]));
-                }
-                auto* baseNode = entry.cachedBaseNode.get();
-                auto* tipNode = entry.cachedTipNode.get();
-
-                // Get middle bones that will actually be moved
-                const std::size_t middleCount = entry.probeNodes.size() > 2 ? entry.probeNodes.size() - 2 : 0;
-                std::vector<RE::NiAVObject*> middleBones;
-                std::vector<std::size_t> middleBoneIndices;
-                middleBones.reserve(middleCount);
-                middleBoneIndices.reserve(middleCount);
-                for (std::size_t idx = 1; idx < entry.probeNodes.size() - 1; ++idx) {
-                    auto& cachedBone = entry.cachedMiddleBones[idx];
-                    if (!cachedBone) {
-                        cachedBone = RE::NiPointer<RE::NiAVObject>(probeActor->GetNodeByName(entry.probeNodes[idx]));
-                    }
-                    auto* bone = cachedBone.get();
-                    if (bone) {
-                        middleBones.push_back(bone);
-                        middleBoneIndices.push_back(idx);
-                    } else {
-                        cachedBone.reset();
-                    }
-                }
+namespace Hooks {
+    // Main::Update, called once per frame on the main thread. The original call updates animation;
+    // running the monitor pass right after it means bone corrections are computed from, and applied
+    // to, the pose that is about to be rendered.
+    struct MainUpdate {
+        static void thunk(RE::Main* a_this, float a_delta) {
+            func(a_this, a_delta);
+            Monitoring::OnMainThreadFrame();
+        }
+        static inline REL::Relocation<decltype(thunk)> func;
+
+        static void Install() {
+            REL::Relocation<std::uintptr_t> target{RELOCATION_ID(35551, 36544), REL::Relocate(0x11F, 0x160)};
+            auto& trampoline = SKSE::GetTrampoline();
+            func = trampoline.write_call<5>(target.address(), thunk);
+            LOG_INFO("Main update hook installed.");
+        }
+    };
+}  // namespace Hooks
+
+namespace Events {
+    // Loading or unloading an actor's 3D replaces its skeleton, so the cached node pointers must go
+    class ObjectLoadedSink final : public RE::BSTEventSink<RE::TESObjectLoadedEvent> {
+    public:
+        static ObjectLoadedSink* GetSingleton() {
+            static ObjectLoadedSink singleton;
+            return &singleton;
+        }
+
+        RE::BSEventNotifyControl ProcessEvent(const RE::TESObjectLoadedEvent* a_event,
+                                              RE::BSTEventSource<RE::TESObjectLoadedEvent>*) override {
+            if (!a_event || Monitoring::s_engine.Size() == 0) {
+                return RE::BSEventNotifyControl::kContinue;
+            }
 
-                if (!targetNode || !baseNode || !tipNode || middleBones.empty()) {
-                    if (!entry.waitingForBones) {
-                        entry.waitingForBones = true;
-                        LOG_INFO(
-                            "Waiting for bones (probeHandle={:#x} targetHandle={:#x} target={} base={} tip={} "
-                            "middle={})",
-                            entry.probeHandle, entry.targetHandle, targetNode ? "ok" : "missing",
-                            baseNode ? "ok" : "missing", tipNode ? "ok" : "missing", middleBones.size());
-                    }
-                    continue;
+            if (auto* actor = RE::TESForm::LookupByID<RE::Actor>(a_event->formID)) {
+                if (const auto handle = actor->GetHandle().native_handle(); handle != 0) {
+                    LOG_DEBUG("3D {} for {}; invalidating node index", a_event->loaded ? "loaded" : "unloaded",
+                              GetActorName(actor));
+                    Monitoring::s_engine.InvalidateActor(handle);
                 }
+            }
+            return RE::BSEventNotifyControl::kContinue;
+        }
+    };
 
-                if (entry.waitingForBones) {
-                    entry.waitingForBones = false;
-                    LOG_INFO("Bones recovered (probeHandle={:#x} targetHandle={:#x})", entry.probeHandle,
-                                    entry.targetHandle);
-                }
+    void Install() {
+        if (auto* holder = RE::ScriptEventSourceHolder::GetSingleton()) {
+            holder->AddEventSink<RE::TESObjectLoadedEvent>(ObjectLoadedSink::GetSingleton());
+            LOG_INFO("Object load event sink registered.");
+        } else {
+            LOG_ERROR("Script event source unavailable; node index will not see 3D reloads.");
+        }
+    }
+}  // namespace Events
 
-                // Calculate probe chain direction vector (base -> tip) using CURRENT positions
-                // Use original local positions only for restoring; penetration should reflect live pose
-                const auto& targetPos = targetNode->world.translate;
-                const auto& baseWorld = baseNode->world.translate;
-                const auto& tipWorld = tipNode->world.translate;
+namespace Papyrus {
+    // Validates a monitor request and queues it; caller names the native in log messages
+    int SubmitBoneMonitor(std::string_view caller, RE::Actor* probeActor, const std::vector<RE::BSFixedString>& probeNodes,
+                          RE::Actor* targetActor, const RE::BSFixedString& targetNodeName, float distanceThreshold,
+                          float restoreThreshold, const char* calibrationKey, const KYL::VolumeSpec& volume = {}) {
+        if (!probeActor || !targetActor) {
+            LOG_ERROR("{}: invalid actor arguments.", caller);
+            return 0;
+        }
 
-                // Calculate direction vector (normalized) from current positions
-                RE::NiPoint3 probeDirection = tipWorld - baseWorld;
-                const float probeLength = probeDirection.Length();
+        if (probeNodes.empty()) {
+            LOG_ERROR("{}: probe node list must be non-empty.", caller);
+            return 0;
+        }
 
-                if (probeLength < 0.001f) {
-                    // Probe bones are too close together, can't determine direction
-                    LOG_DEBUG("Probe bones too close together (probeHandle={:#x})", entry.probeHandle);
-                    continue;
-                }
+        for (const auto& name : probeNodes) {
+            const char* data = name.data();
+            if (!data || *data == '\0') {
+                LOG_ERROR("{}: probe node names must be non-empty.", caller);
+                return 0;
+            }
+        }
 
-                probeDirection = probeDirection / probeLength;  // Normalize
-
-                // Calculate penetration depth for tip bone only
-                // Vector from target to tip (using CURRENT tip position)
-                RE::NiPoint3 targetToTip = tipWorld - targetPos;
-
-                // Project onto probe direction to get penetration depth
-                // Positive = probe has gone beyond target in forward direction
-                // Negative = probe hasn't reached target yet
-                float tipPenetration = targetToTip.Dot(probeDirection);
-
-                LOG_TRACE(
-                    "Penetration check: probeHandle={:#x} tipPenetration={:.3f} shrinkThreshold={:.3f} "
-                    "restoreThreshold={:.3f}",
-                    entry.probeHandle, tipPenetration, entry.distanceThreshold, entry.restoreThreshold);
-
-                if (tipPenetration > entry.distanceThreshold) {
-                    // Track max for telemetry, but drive offset from cached maximum beyond threshold
-                    if (tipPenetration > entry.maxPenetration) {
-                        entry.maxPenetration = tipPenetration;
-                        LOG_DEBUG("New max penetration: {:.3f} (probeHandle={:#x})", entry.maxPenetration,
-                                         entry.probeHandle);
-                    }
-
-                    const float currentBeyondThreshold = tipPenetration - entry.distanceThreshold;
-                    bool newMaxBeyond = false;
-                    if (currentBeyondThreshold > entry.maxPenetrationBeyondThreshold) {
-                        entry.maxPenetrationBeyondThreshold = currentBeyondThreshold;
-                        newMaxBeyond = true;
-                        LOG_DEBUG("New max penetration beyond threshold: {:.3f} (probeHandle={:#x})",
-                                         entry.maxPenetrationBeyondThreshold, entry.probeHandle);
-                    }
-
-                    // Use cached maximum penetration beyond threshold for offset calculation
-                    float penetrationBeyondThreshold = entry.maxPenetrationBeyondThreshold;
-
-                    // Distribute offset evenly across all middle bones
-                    float distributedOffset = penetrationBeyondThreshold / static_cast<float>(middleBones.size());
-
-                    // Clamp offset to prevent runaway feedback loop
-                    distributedOffset = std::min(distributedOffset, kMaxBoneOffset);
-
-                    // Only update bones when we achieved a new max OR they have been restored to original length
-                    for (std::size_t i = 0; i < middleBones.size(); ++i) {
-                        const std::size_t boneIdx = middleBoneIndices[i];
-                        const bool wasMoved = entry.movedFlags[boneIdx];
-
-                        if (!newMaxBeyond && wasMoved) {
-                            continue;  // already at max
-                        }
+        // Require at least base, middle, and tip bones
+        if (probeNodes.size() < 3) {
+            LOG_ERROR("{}: probe node list must contain at least 3 nodes (base, middle, tip).", caller);
+            return 0;
+        }
 
-                        MoveBoneToTarget(probeActor.get(), entry.probeNodes[boneIdx], distributedOffset);
-                        entry.movedFlags[boneIdx] = true;
+        const char* targetNodeData = targetNodeName.data();
+        if (!targetNodeData || *targetNodeData == '\0') {
+            LOG_ERROR("{}: target node name must be non-empty.", caller);
+            return 0;
+        }
 
-                        if (!wasMoved) {
-                            LOG_TRACE(
-                                "Moved bone (probeHandle={:#x} node={} distributedOffset={:.2f} tipPenetration={:.2f} "
-                                "maxPenetration={:.2f} threshold={:.2f})",
-                                entry.probeHandle, GetNodeLabel(entry.probeNodes[boneIdx]), distributedOffset,
-                                tipPenetration, entry.maxPenetration, entry.distanceThreshold);
-                        }
-                    }
-                } else if (tipPenetration <= entry.restoreThreshold) {
-                    // Tip is at or below restore threshold - restore all moved middle bones to original positions
-                    for (std::size_t i = 0; i < middleBones.size(); ++i) {
-                        const std::size_t boneIdx = middleBoneIndices[i];
-                        if (entry.movedFlags[boneIdx]) {
-                            RestoreBonePosition(probeActor.get(), entry.probeNodes[boneIdx]);
-                            entry.movedFlags[boneIdx] = false;
-                            LOG_TRACE(
-                                "Restored bone (probeHandle={:#x} node={} tipPenetration={:.2f} "
-                                "restoreThreshold={:.2f})",
-                                entry.probeHandle, GetNodeLabel(entry.probeNodes[boneIdx]), tipPenetration,
-                                entry.restoreThreshold);
-                        }
-                    }
-                    // Keep maxPenetration - it represents the learned maximum for this looped animation
-                    // Only reset when monitor is removed/recreated
-                }
-                // else: tipPenetration is between restoreThreshold and distanceThreshold - maintain current state
-            }
+        const auto ticket = Monitoring::AddMonitor(probeActor, probeNodes, targetActor, targetNodeName,
+                                                   distanceThreshold, restoreThreshold, calibrationKey, volume);
+        if (ticket == 0) {
+            LOG_ERROR("{}: failed to start monitoring.", caller);
+            return 0;
+        }
 
-            // Remove monitors in reverse order to maintain indices
-            for (auto it = monitorsToRemove.rbegin(); it != monitorsToRemove.rend(); ++it) {
-                if (*it < s_monitors.size()) {
-                    s_monitors.erase(s_monitors.begin() + *it);
-                }
-            }
+        LOG_INFO("{}: #{} queued {}.[{}] -> {}.{} (shrink {:.2f}, restore {:.2f}, lifetime until stopped)", caller,
+            ticket, GetActorName(probeActor), JoinNodeLabels(probeNodes), GetActorName(targetActor),
+            GetNodeLabel(targetNodeName), distanceThreshold, restoreThreshold);
+        return static_cast<int>(ticket);
+    }
 
-            // Check if we still have active monitors
-            if (s_monitors.empty()) {
-                // Use atomic instead of mutex to avoid potential deadlock
-                s_uiTickActive.store(false, std::memory_order_release);
-                LOG_INFO("No more active monitors, stopping tick.");
-                return;
-            }
+    // Returns the ticket of the queued request (shown in the log when it is applied), or 0 if rejected
+    int QueueBoneMonitor(RE::StaticFunctionTag*, RE::Actor* probeActor,
+                         RE::reference_array<RE::BSFixedString> probeNodeNames, RE::Actor* targetActor,
+                         RE::BSFixedString targetNodeName, float distanceThreshold, float restoreThreshold,
+                         RE::BSFixedString calibrationKey) {
+        LOG_INFO(
+            "QueueBoneMonitor invoked (probeActor={}, targetActor={}, shrinkThreshold={:.2f}, "
+            "restoreThreshold={:.2f}, probeNodes={}, calibrationKey={})",
+            static_cast<const void*>(probeActor), static_cast<const void*>(targetActor), distanceThreshold,
+            restoreThreshold, probeNodeNames.size(), calibrationKey.c_str());
 
-            // Schedule next tick
-            ScheduleNextTick();
-        }
-    }  // namespace Monitoring
-}  // namespace
+        const std::vector<RE::BSFixedString> probeNodes(probeNodeNames.begin(), probeNodeNames.end());
+        return SubmitBoneMonitor("QueueBoneMonitor", probeActor, probeNodes, targetActor, targetNodeName,
+                                 distanceThreshold, restoreThreshold, calibrationKey.c_str());
+    }
 
-namespace Papyrus {
+    // Published signature, kept for scripts compiled against it: true once the request is queued
     bool RegisterBoneMonitor(RE::StaticFunctionTag*, RE::Actor* probeActor,
                              RE::reference_array<RE::BSFixedString> probeNodeNames, RE::Actor* targetActor,
                              RE::BSFixedString targetNodeName, float distanceThreshold, float restoreThreshold) {
@@ -687,52 +598,226 @@ namespace Papyrus {
             static_cast<const void*>(probeActor), static_cast<const void*>(targetActor), distanceThreshold,
             restoreThreshold, probeNodeNames.size());
 
-        if (!probeActor || !targetActor) {
-            LOG_ERROR("RegisterBoneMonitor: invalid actor arguments.");
-            return false;
-        }
+        const std::vector<RE::BSFixedString> probeNodes(probeNodeNames.begin(), probeNodeNames.end());
+        return SubmitBoneMonitor("RegisterBoneMonitor", probeActor, probeNodes, targetActor, targetNodeName,
+                                 distanceThreshold, restoreThreshold, "") != 0;
+    }
 
-        if (probeNodeNames.empty()) {
-            LOG_ERROR("RegisterBoneMonitor: probe node list must be non-empty.");
-            return false;
+    // Like RegisterBoneMonitor, with the probe chain, target bone, thresholds and volume test taken from the loaded
+    // config.json block of actionType ("oral", "vaginal" or "anal")
+    int RegisterActionMonitor(RE::StaticFunctionTag*, RE::Actor* probeActor, RE::Actor* targetActor,
+                              RE::BSFixedString actionType, RE::BSFixedString calibrationKey) {
+        LOG_INFO("RegisterActionMonitor invoked (probeActor={}, targetActor={}, actionType={}, calibrationKey={})",
+                 static_cast<const void*>(probeActor), static_cast<const void*>(targetActor), actionType.c_str(),
+                 calibrationKey.c_str());
+
+        const auto type = KYL::ParseActionType(actionType.c_str());
+        if (!type) {
+            LOG_ERROR("RegisterActionMonitor: unknown action type '{}'.", actionType.c_str());
+            return 0;
         }
 
+        const auto config = Monitoring::GetConfigStore().Get();
+        const auto& action = config->GetAction(*type);
         std::vector<RE::BSFixedString> probeNodes;
-        probeNodes.reserve(probeNodeNames.size());
-        for (const auto& name : probeNodeNames) {
-            const char* data = name.data();
-            if (!data || *data == '\0') {
-                LOG_ERROR("RegisterBoneMonitor: probe node names must be non-empty.");
-                return false;
+        probeNodes.reserve(config->penisBones.size());
+        for (const auto& name : config->penisBones) {
+            probeNodes.emplace_back(name.c_str());
+        }
+        return SubmitBoneMonitor("RegisterActionMonitor", probeActor, probeNodes, targetActor,
+                                RE::BSFixedString{action.bone.c_str()}, action.threshold, action.restoreThreshold,
+                                calibrationKey.c_str(), action.volume);
+    }
+
+    // Specs for the parallel scene arrays: entry i monitors probeActors[i] against targetActors[i] with the
+    // config block of actionTypes[i]. Entries with a missing actor or an empty or unknown type are skipped,
+    // so callers can pass arrays sized to the scene's action count. Empty if the config has no usable chain.
+    std::optional<std::vector<KYL::MonitorSpec>> MakeSceneSpecs(std::string_view caller,
+                                                                const RE::reference_array<RE::Actor*>& probeActors,
+                                                                const RE::reference_array<RE::Actor*>& targetActors,
+                                                                const RE::reference_array<RE::BSFixedString>& actionTypes,
+                                                                const RE::BSFixedString& calibrationKey) {
+        const auto count = std::min({probeActors.size(), targetActors.size(), actionTypes.size()});
+        if (probeActors.size() != count || targetActors.size() != count || actionTypes.size() != count) {
+            LOG_WARN("{}: array lengths differ ({}, {}, {}); using the first {}", caller, probeActors.size(),
+                     targetActors.size(), actionTypes.size(), count);
+        }
+
+        const auto config = Monitoring::GetConfigStore().Get();
+        if (config->penisBones.size() < 3) {
+            LOG_ERROR("{}: penisBones must list at least 3 nodes (base, middle, tip).", caller);
+            return std::nullopt;
+        }
+
+        std::vector<KYL::MonitorSpec> specs;
+        specs.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            RE::Actor* probeActor = probeActors[i];
+            RE::Actor* targetActor = targetActors[i];
+            const auto type = KYL::ParseActionType(actionTypes[i].c_str());
+            if (!probeActor || !targetActor || !type) {
+                continue;
+            }
+
+            const auto& action = config->GetAction(*type);
+            if (action.bone.empty()) {
+                continue;
             }
-            probeNodes.push_back(name);
+
+            KYL::MonitorSpec& spec = specs.emplace_back();
+            spec.probeHandle = probeActor->GetHandle().native_handle();
+            spec.targetHandle = targetActor->GetHandle().native_handle();
+            spec.probeNodes = config->penisBones;
+            spec.targetNode = action.bone;
+            spec.distanceThreshold = action.threshold;
+            spec.restoreThreshold = action.restoreThreshold;
+            spec.volume = action.volume;
+            spec.calibrationKey = calibrationKey.c_str();
+        }
+        return specs;
+    }
+
+    // Registers every action of a scene in one call (see MakeSceneSpecs). Returns the batch ticket.
+    int RegisterSceneMonitors(RE::StaticFunctionTag*, RE::reference_array<RE::Actor*> probeActors,
+                              RE::reference_array<RE::Actor*> targetActors,
+                              RE::reference_array<RE::BSFixedString> actionTypes, RE::BSFixedString calibrationKey) {
+        auto specs = MakeSceneSpecs("RegisterSceneMonitors", probeActors, targetActors, actionTypes, calibrationKey);
+        if (!specs) {
+            return 0;
         }
 
-        // Require at least base, middle, and tip bones
-        if (probeNodes.size() < 3) {
-            LOG_ERROR("RegisterBoneMonitor: probe node list must contain at least 3 nodes (base, middle, tip).");
-            return false;
+        const auto requested = specs->size();
+        const auto ticket = requested > 0 ? Monitoring::AddMonitors(std::move(*specs)) : 0;
+        LOG_INFO("RegisterSceneMonitors invoked ({} monitor(s), calibrationKey={}), queued #{}", requested,
+                 calibrationKey.c_str(), ticket);
+        return static_cast<int>(ticket);
+    }
+
+    // Makes the scene arrays (see MakeSceneSpecs) the monitor set of sceneActors and of the actors they name.
+    // Pairs that keep running keep their moved bones and learned maxima; only dropped ones are restored.
+    int ApplySceneMonitors(RE::StaticFunctionTag*, RE::reference_array<RE::Actor*> sceneActors,
+                           RE::reference_array<RE::Actor*> probeActors, RE::reference_array<RE::Actor*> targetActors,
+                           RE::reference_array<RE::BSFixedString> actionTypes, RE::BSFixedString calibrationKey) {
+        auto specs = MakeSceneSpecs("ApplySceneMonitors", probeActors, targetActors, actionTypes, calibrationKey);
+        if (!specs) {
+            return 0;
         }
 
-        const char* targetNodeData = targetNodeName.data();
-        if (!targetNodeData || *targetNodeData == '\0') {
-            LOG_ERROR("RegisterBoneMonitor: target node name must be non-empty.");
-            return false;
+        std::vector<std::uint32_t> handles;
+        handles.reserve(sceneActors.size());
+        for (const auto& actor : sceneActors) {
+            if (actor) {
+                if (const auto handle = actor->GetHandle().native_handle(); handle != 0) {
+                    handles.push_back(handle);
+                }
+            }
         }
 
-        if (!Monitoring::AddMonitor(probeActor, probeNodes, targetActor, targetNodeName, distanceThreshold,
-                                    restoreThreshold)) {
-            LOG_ERROR("RegisterBoneMonitor: failed to start monitoring.");
-            return false;
+        const auto requested = specs->size();
+        const auto ticket = Monitoring::ApplyMonitorSet(std::move(handles), std::move(*specs));
+        LOG_INFO("ApplySceneMonitors invoked ({} monitor(s), calibrationKey={}), queued #{}", requested,
+                 calibrationKey.c_str(), ticket);
+        return static_cast<int>(ticket);
+    }
+
+    bool HasScenePlan(RE::StaticFunctionTag*, RE::BSFixedString sceneId) {
+        return Monitoring::s_scenePlans.Contains(sceneId.c_str());
+    }
+
+    // Records a scene's actions (parallel arrays of action name and actor/target slot) so later scene
+    // changes to it only need ApplyScenePlan
+    bool DefineScenePlan(RE::StaticFunctionTag*, RE::BSFixedString sceneId,
+                         RE::reference_array<RE::BSFixedString> actionNames, RE::reference_array<std::int32_t> actorSlots,
+                         RE::reference_array<std::int32_t> targetSlots) {
+        const auto count = std::min({actionNames.size(), actorSlots.size(), targetSlots.size()});
+        if (actionNames.size() != count || actorSlots.size() != count || targetSlots.size() != count) {
+            LOG_WARN("DefineScenePlan: array lengths differ ({}, {}, {}); using the first {}", actionNames.size(),
+                     actorSlots.size(), targetSlots.size(), count);
         }
 
-        LOG_INFO("RegisterBoneMonitor: monitoring {}.[{}] -> {}.{} (shrink {:.2f}, restore {:.2f}, lifetime until stopped)",
-            GetActorName(probeActor), JoinNodeLabels(probeNodes), GetActorName(targetActor),
-            GetNodeLabel(targetNodeName), distanceThreshold, restoreThreshold);
+        std::vector<KYL::SceneAction> actions;
+        actions.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            actions.push_back({actionNames[i].c_str(), actorSlots[i], targetSlots[i]});
+        }
+        Monitoring::s_scenePlans.Define(sceneId.c_str(), std::move(actions));
+        LOG_DEBUG("DefineScenePlan: {} with {} action(s)", sceneId.c_str(), count);
         return true;
     }
 
-    bool StopBoneMonitor(RE::StaticFunctionTag*, RE::reference_array<RE::Actor*> actors) {
+    // Applies the plan of sceneId as the monitor set of sceneActors (diffed like ApplySceneMonitors), with
+    // sceneId as calibration key. Returns the ticket, or 0 if the scene has no plan.
+    int ApplyScenePlan(RE::StaticFunctionTag*, RE::BSFixedString sceneId, RE::reference_array<RE::Actor*> sceneActors) {
+        const auto plan = Monitoring::s_scenePlans.Get(sceneId.c_str(), Monitoring::GetConfigStore().Get());
+        if (!plan) {
+            LOG_WARN("ApplyScenePlan: no plan for scene {}", sceneId.c_str());
+            return 0;
+        }
+        if (!plan->entries.empty() && plan->probeNodes.size() < 3) {
+            LOG_ERROR("ApplyScenePlan: penisBones must list at least 3 nodes (base, middle, tip).");
+            return 0;
+        }
+
+        const auto slotHandle = [&sceneActors](std::int32_t slot) -> std::uint32_t {
+            if (slot < 0 || static_cast<std::size_t>(slot) >= sceneActors.size() || !sceneActors[slot]) {
+                return 0;
+            }
+            return sceneActors[slot]->GetHandle().native_handle();
+        };
+
+        std::vector<KYL::MonitorSpec> specs;
+        specs.reserve(plan->entries.size());
+        for (const auto& entry : plan->entries) {
+            const auto probeHandle = slotHandle(entry.probeSlot);
+            const auto targetHandle = slotHandle(entry.targetSlot);
+            if (probeHandle == 0 || targetHandle == 0 || entry.targetNode.empty()) {
+                continue;
+            }
+
+            KYL::MonitorSpec& spec = specs.emplace_back();
+            spec.probeHandle = probeHandle;
+            spec.targetHandle = targetHandle;
+            spec.probeNodes = plan->probeNodes;
+            spec.targetNode = entry.targetNode;
+            spec.distanceThreshold = entry.threshold;
+            spec.restoreThreshold = entry.restoreThreshold;
+            spec.volume = entry.volume;
+            spec.calibrationKey = sceneId.c_str();
+        }
+
+        std::vector<std::uint32_t> handles;
+        handles.reserve(sceneActors.size());
+        for (std::size_t slot = 0; slot < sceneActors.size(); ++slot) {
+            if (const auto handle = slotHandle(static_cast<std::int32_t>(slot)); handle != 0) {
+                handles.push_back(handle);
+            }
+        }
+
+        const auto requested = specs.size();
+        const auto ticket = Monitoring::ApplyMonitorSet(std::move(handles), std::move(specs));
+        LOG_INFO("ApplyScenePlan: scene {} -> {} monitor(s), queued #{}", sceneId.c_str(), requested, ticket);
+        return static_cast<int>(ticket);
+    }
+
+    // Action type ("oral", "vaginal", "anal") whose config block lists the OStim action, or "" if none does
+    RE::BSFixedString GetOStimActionType(RE::StaticFunctionTag*, RE::BSFixedString actionName) {
+        const auto type = Monitoring::GetConfigStore().Get()->FindOStimAction(actionName.c_str());
+        return type ? RE::BSFixedString{KYL::GetActionTypeName(*type).data()} : RE::BSFixedString{};
+    }
+
+    RE::BSFixedString GetSexlabTagType(RE::StaticFunctionTag*, RE::BSFixedString tagName) {
+        const auto type = Monitoring::GetConfigStore().Get()->FindSexlabTag(tagName.c_str());
+        return type ? RE::BSFixedString{KYL::GetActionTypeName(*type).data()} : RE::BSFixedString{};
+    }
+
+    // Re-reads config.json and applies its general settings; false keeps the previous config
+    bool ReloadConfig(RE::StaticFunctionTag*) {
+        LOG_INFO("ReloadConfig invoked");
+        return Monitoring::GetConfigStore().Reload();
+    }
+
+    // Returns the ticket of the queued removal; the number of stopped monitors is logged when it is applied
+    int QueueStopBoneMonitor(RE::StaticFunctionTag*, RE::reference_array<RE::Actor*> actors) {
         std::vector<std::uint32_t> handles;
         handles.reserve(actors.size());
 
@@ -745,24 +830,15 @@ namespace Papyrus {
             }
         }
 
-        const auto removed = Monitoring::RemoveMonitors(handles);
-        LOG_INFO("StopBoneMonitor invoked (requested actors={}, removed monitors={})", handles.size(), removed);
-        if (removed == 0) {
-            if (handles.empty()) {
-                LOG_WARN("StopBoneMonitor: no active monitors.");
-            } else {
-                LOG_WARN("StopBoneMonitor: no monitors matched {} actor(s).", handles.size());
-            }
-            return false;
-        }
-
-        if (handles.empty()) {
-            LOG_INFO("StopBoneMonitor: stopped all {} monitor(s).", removed);
-        } else {
-            LOG_INFO("StopBoneMonitor: stopped {} monitor(s) for {} actor(s).", removed, handles.size());
-        }
+        const auto requested = handles.size();
+        const auto ticket = Monitoring::RemoveMonitors(std::move(handles));
+        LOG_INFO("StopBoneMonitor invoked (requested actors={}), queued #{}", requested, ticket);
+        return static_cast<int>(ticket);
+    }
 
-        return true;
+    // Published signature, kept for scripts compiled against it: true once the removal is queued
+    bool StopBoneMonitor(RE::StaticFunctionTag* tag, RE::reference_array<RE::Actor*> actors) {
+        return QueueStopBoneMonitor(tag, std::move(actors)) != 0;
     }
 
     void SetTickInterval(RE::StaticFunctionTag*, int intervalMs) {
@@ -777,11 +853,101 @@ namespace Papyrus {
         return interval;
     }
 
+    void SetTickFrameDivisor(RE::StaticFunctionTag*, int frames) {
+        LOG_INFO("SetTickFrameDivisor invoked (frames={})", frames);
+        Monitoring::SetTickFrameDivisor(frames);
+    }
+
+    int GetTickFrameDivisor(RE::StaticFunctionTag*) {
+        return Monitoring::GetTickFrameDivisor();
+    }
+
+    void SetPredictionLookAhead(RE::StaticFunctionTag*, float ticks) {
+        LOG_INFO("SetPredictionLookAhead invoked (ticks={:.2f})", ticks);
+        Monitoring::SetPredictionLookAhead(ticks);
+    }
+
+    float GetPredictionLookAhead(RE::StaticFunctionTag*) {
+        return Monitoring::GetPredictionLookAhead();
+    }
+
+    void SetLoopLearning(RE::StaticFunctionTag*, bool enabled) {
+        LOG_INFO("SetLoopLearning invoked (enabled={})", enabled);
+        Monitoring::SetLoopLearning(enabled);
+    }
+
+    bool IsLoopLearningEnabled(RE::StaticFunctionTag*) {
+        return Monitoring::IsLoopLearningEnabled();
+    }
+
+    // Record every monitor evaluation to fileName next to the log (KnowYourLimits.samples if empty)
+    bool StartSampleRecording(RE::StaticFunctionTag*, RE::BSFixedString fileName) {
+        LOG_INFO("StartSampleRecording invoked (fileName={})", fileName.c_str());
+        return Monitoring::StartSampleRecording(fileName.c_str());
+    }
+
+    int StopSampleRecording(RE::StaticFunctionTag*) {
+        const int written = Monitoring::StopSampleRecording();
+        LOG_INFO("StopSampleRecording invoked, {} sample(s) written", written);
+        return written;
+    }
+
+    // Record a Chrome trace of registration, tick scheduling, ticks and bone writes until StopTrace
+    void StartTrace(RE::StaticFunctionTag*) {
+        LOG_INFO("StartTrace invoked");
+        KYL::Tracer::Start();
+    }
+
+    // Writes the trace to fileName next to the log (KnowYourLimits.trace.json if empty); returns the
+    // number of spans written, or -1 on failure
+    int StopTrace(RE::StaticFunctionTag*, RE::BSFixedString fileName) {
+        LOG_INFO("StopTrace invoked (fileName={})", fileName.c_str());
+        return Monitoring::StopTrace(fileName.c_str());
+    }
+
+    // Tick cost since the game was loaded: [0] ticks, [1] monitors, then p50, p99 and max of queue delay (us),
+    // tick time (us), time per evaluated monitor (ns), bone writes per tick and bone lookup misses per tick
+    std::vector<float> GetMonitorStats(RE::StaticFunctionTag*) {
+        const auto& metrics = Monitoring::s_engine.GetMetrics();
+        std::vector<float> stats{static_cast<float>(metrics.tickUs.Summarize().count),
+                                 static_cast<float>(Monitoring::s_engine.Size())};
+        for (const auto* histogram : {&metrics.queueDelayUs, &metrics.tickUs, &metrics.monitorNs, &metrics.boneWrites,
+                                      &metrics.nodeMisses}) {
+            const auto summary = histogram->Summarize();
+            stats.push_back(static_cast<float>(summary.p50));
+            stats.push_back(static_cast<float>(summary.p99));
+            stats.push_back(static_cast<float>(summary.max));
+        }
+        return stats;
+    }
+
     bool RegisterFunctions(RE::BSScript::IVirtualMachine* vm) {
         vm->RegisterFunction("RegisterBoneMonitor"sv, "KnowYourLimits"sv, RegisterBoneMonitor);
+        vm->RegisterFunction("QueueBoneMonitor"sv, "KnowYourLimits"sv, QueueBoneMonitor);
+        vm->RegisterFunction("RegisterActionMonitor"sv, "KnowYourLimits"sv, RegisterActionMonitor);
+        vm->RegisterFunction("RegisterSceneMonitors"sv, "KnowYourLimits"sv, RegisterSceneMonitors);
+        vm->RegisterFunction("ApplySceneMonitors"sv, "KnowYourLimits"sv, ApplySceneMonitors);
+        vm->RegisterFunction("HasScenePlan"sv, "KnowYourLimits"sv, HasScenePlan);
+        vm->RegisterFunction("DefineScenePlan"sv, "KnowYourLimits"sv, DefineScenePlan);
+        vm->RegisterFunction("ApplyScenePlan"sv, "KnowYourLimits"sv, ApplyScenePlan);
+        vm->RegisterFunction("GetOStimActionType"sv, "KnowYourLimits"sv, GetOStimActionType);
+        vm->RegisterFunction("GetSexlabTagType"sv, "KnowYourLimits"sv, GetSexlabTagType);
+        vm->RegisterFunction("ReloadConfig"sv, "KnowYourLimits"sv, ReloadConfig);
         vm->RegisterFunction("StopBoneMonitor"sv, "KnowYourLimits"sv, StopBoneMonitor);
+        vm->RegisterFunction("QueueStopBoneMonitor"sv, "KnowYourLimits"sv, QueueStopBoneMonitor);
         vm->RegisterFunction("SetTickInterval"sv, "KnowYourLimits"sv, SetTickInterval);
         vm->RegisterFunction("GetTickInterval"sv, "KnowYourLimits"sv, GetTickInterval);
+        vm->RegisterFunction("SetTickFrameDivisor"sv, "KnowYourLimits"sv, SetTickFrameDivisor);
+        vm->RegisterFunction("GetTickFrameDivisor"sv, "KnowYourLimits"sv, GetTickFrameDivisor);
+        vm->RegisterFunction("SetPredictionLookAhead"sv, "KnowYourLimits"sv, SetPredictionLookAhead);
+        vm->RegisterFunction("GetPredictionLookAhead"sv, "KnowYourLimits"sv, GetPredictionLookAhead);
+        vm->RegisterFunction("SetLoopLearning"sv, "KnowYourLimits"sv, SetLoopLearning);
+        vm->RegisterFunction("IsLoopLearningEnabled"sv, "KnowYourLimits"sv, IsLoopLearningEnabled);
+        vm->RegisterFunction("StartSampleRecording"sv, "KnowYourLimits"sv, StartSampleRecording);
+        vm->RegisterFunction("StopSampleRecording"sv, "KnowYourLimits"sv, StopSampleRecording);
+        vm->RegisterFunction("GetMonitorStats"sv, "KnowYourLimits"sv, GetMonitorStats);
+        vm->RegisterFunction("StartTrace"sv, "KnowYourLimits"sv, StartTrace);
+        vm->RegisterFunction("StopTrace"sv, "KnowYourLimits"sv, StopTrace);
         LOG_INFO("Papyrus functions registered.");
         return true;
     }
@@ -795,6 +961,10 @@ SKSEPluginLoad(const SKSE::LoadInterface* skse) {
 
     // Note: monitoring code obtains the task interface lazily with SKSE::GetTaskInterface().
 
+    // Frame-synchronized ticks hook the per-frame main-thread update
+    SKSE::AllocTrampoline(14);
+    Hooks::MainUpdate::Install();
+
     if (const auto* messaging = SKSE::GetMessagingInterface()) {
         if (!messaging->RegisterListener([](SKSE::MessagingInterface::Message* message) {
                 switch (message->type) {
@@ -806,6 +976,10 @@ SKSEPluginLoad(const SKSE::LoadInterface* skse) {
 
                     case SKSE::MessagingInterface::kDataLoaded:
                         LOG_INFO("Data loaded successfully.");
+                        KYL::Tracer::SetThreadName("Main");
+                        Events::Install();
+                        Monitoring::OpenCalibrationCache();
+                        Monitoring::OpenConfig();
                         if (auto* console = RE::ConsoleLog::GetSingleton()) {
                             console->Print("Know Your Limits: Ready");
                         }
@@ -842,3 +1016,6 @@ SKSEPluginLoad(const SKSE::LoadInterface* skse) {
 // be destroyed when our destructor runs, causing crashes.
 // Instead, we rely on game state messages (kPostLoadGame, kNewGame) to cleanup,
 // which is the proper way to handle this in SKSE plugins.
+// For the same reason the objects that own threads (tick scheduler, calibration
+// cache, sample recorder, config store) are allocated once and leaked: joining
+// their threads from a static destructor would run after those statics are gone.